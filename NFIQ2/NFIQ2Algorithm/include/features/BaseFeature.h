@@ -1,9 +1,12 @@
 #ifndef BASEFEATURE_H
 #define BASEFEATURE_H
 
+#include <nfiq2_featurevector.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 
+#include <bitset>
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -21,19 +24,44 @@ class BaseFeature {
 	/** @return computed quality feature speed */
 	virtual NFIQ2::QualityFeatureSpeed getSpeed() const;
 
-	/** @return computed quality features */
+	/**
+	 * @return
+	 * computed quality features in FeatureIndex order, built from the
+	 * feature values
+	 */
 	virtual std::vector<NFIQ2::QualityFeatureResult> getFeatures() const;
 
+	/**
+	 * @brief
+	 * Copy the computed feature values into their slots of a vector.
+	 *
+	 * @param featureVector
+	 * Vector whose slots of the features computed by this module are
+	 * overwritten.
+	 *
+	 * @return
+	 * Number of features copied.
+	 */
+	std::size_t copyFeatureValues(
+	    NFIQ2::FeatureVector &featureVector) const;
+
     protected:
 	void setSpeed(const NFIQ2::QualityFeatureSpeed &featureSpeed);
 
-	void setFeatures(
-	    const std::vector<NFIQ2::QualityFeatureResult> &featureResult);
+	/** Store the value of the feature at index */
+	void setFeature(const NFIQ2::FeatureIndex index, const double value);
+
+	/** Store values of consecutive features, starting at first */
+	void setFeatures(const NFIQ2::FeatureIndex first,
+	    const std::vector<double> &values);
 
     private:
 	NFIQ2::QualityFeatureSpeed speed {};
 
-	std::vector<NFIQ2::QualityFeatureResult> features {};
+	/** Values of the features computed by this module, 0 elsewhere */
+	NFIQ2::FeatureVector featureValues {};
+	/** Slots of featureValues set by this module */
+	std::bitset<NFIQ2::FeatureVector::Size> computedFeatures {};
 };
 
 }}
@@ -0,0 +1,125 @@
+#ifndef BLOCKWORKSPACE_H
+#define BLOCKWORKSPACE_H
+
+#include <opencv2/core.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace NFIQ2 { namespace QualityFeatures {
+
+/**
+ * Scratch matrices reused by the feature functions that are called once per
+ * block of an image. Each thread owns one workspace, so after the first block
+ * of a given size a thread processes, the buffers are only resized when the
+ * block geometry changes. The threads of parallelFor() persist across calls
+ * and thereby keep their workspaces.
+ */
+class BlockWorkspace {
+    public:
+	/** Scratch matrices available in a workspace. */
+	enum class Buffer {
+		/** block converted to CV_64F (covcoef) */
+		DoubleBlock,
+		/** transposed DoubleBlock (covcoef) */
+		TransposedBlock,
+		/** gradient across the columns (covcoef) */
+		GradientX,
+		/** gradient across the rows of TransposedBlock (covcoef) */
+		TransposedGradientX,
+		/** gradient across the rows (covcoef) */
+		GradientY,
+		/** element-wise square of GradientX (covcoef) */
+		GradientXSquared,
+		/** element-wise square of GradientY (covcoef) */
+		GradientYSquared,
+		/** element-wise product of both gradients (covcoef) */
+		GradientProduct,
+		/** per column rotation offsets (getRotatedBlockWindow) */
+		RotationColumnOffsets,
+		/** window of the rotated block (fda, loclar, rvuhist) */
+		RotatedBlock,
+		/** means of the columns (getRidgeValleyStructure) */
+		ColumnMeans,
+		/** means of the rows (fda) */
+		RowMeans,
+		/** transposed RowMeans padded for the DFT (fda) */
+		SpectrumReal,
+		/** imaginary part of the DFT input (fda) */
+		SpectrumImaginary,
+		/** complex DFT input and output (fda) */
+		Spectrum,
+		/** absolute value of the DFT magnitude (fda) */
+		Amplitude,
+
+		/** number of buffers, not a buffer */
+		Count
+	};
+
+	/** Buffer use and allocation counts. */
+	struct Statistics {
+		/** number of times a buffer was requested */
+		uint64_t requests {};
+		/**
+		 * number of requests that had to (re)allocate the buffer,
+		 * i.e., would have allocated without the workspace too
+		 */
+		uint64_t allocations {};
+	};
+
+	BlockWorkspace();
+	~BlockWorkspace();
+
+	BlockWorkspace(const BlockWorkspace &) = delete;
+	BlockWorkspace &operator=(const BlockWorkspace &) = delete;
+
+	/** @return workspace owned by the calling thread */
+	static BlockWorkspace &forCurrentThread();
+
+	/**
+	 * @brief
+	 * Obtain a scratch matrix of the given geometry.
+	 *
+	 * @details
+	 * The content of the matrix is undefined. It stays valid until the
+	 * same buffer is requested again by the same thread.
+	 *
+	 * @param buffer
+	 * Buffer to obtain.
+	 * @param rows
+	 * Number of rows.
+	 * @param cols
+	 * Number of columns.
+	 * @param type
+	 * OpenCV matrix type.
+	 *
+	 * @return
+	 * Matrix of the workspace, allocated only if its geometry changed.
+	 */
+	cv::Mat &get(Buffer buffer, int rows, int cols, int type);
+
+	/**
+	 * @return
+	 * Counts accumulated by the workspaces of all threads since the last
+	 * call to resetStatistics().
+	 */
+	static Statistics getStatistics();
+
+	/** Resets the counts of the workspaces of all threads. */
+	static void resetStatistics();
+
+    private:
+	std::array<cv::Mat, static_cast<std::size_t>(Buffer::Count)>
+	    buffers {};
+
+	std::atomic<uint64_t> requests { 0 };
+	std::atomic<uint64_t> allocations { 0 };
+};
+
+}}
+
+#endif
+
+/******************************************************************************/
@@ -1,6 +1,7 @@
 #ifndef FDAFEATURE_H
 #define FDAFEATURE_H
 #include <features/BaseFeature.h>
+#include <features/ImageAnalysisContext.h>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 
@@ -21,6 +22,7 @@ static double FDAHISTLIMITS[9] = { 0.268, 0.304, 0.33, 0.355, 0.38, 0.407, 0.44,
 class FDAFeature : public BaseFeature {
     public:
 	FDAFeature(const NFIQ2::FingerprintImageData &fingerprintImage);
+	FDAFeature(const ImageAnalysisContext &context);
 	virtual ~FDAFeature();
 
 	std::string getModuleName() const override;
@@ -30,14 +32,13 @@ class FDAFeature : public BaseFeature {
 	static const std::string moduleName;
 
     private:
-	std::vector<NFIQ2::QualityFeatureResult> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	void computeFeatureData(
+	    const ImageAnalysisContext &context);
 
 	const int blocksize { 32 };
-	const double threshold { .1 };
 	const int slantedBlockSizeX { 32 };
 	const int slantedBlockSizeY { 16 };
-	const bool padFlag { true }; // used by getRotatedBlock
+	const bool padFlag { true }; // used by getRotatedBlockWindow
 };
 }}
 
@@ -3,6 +3,9 @@
 
 #include <features/BaseFeature.h>
 #include <features/FingerJetFXFeature.h>
+#include <features/GradientIntegrals.h>
+#include <features/ImageAnalysisContext.h>
+#include <features/IntensityIntegrals.h>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 #include <opencv2/core/core.hpp>
@@ -33,6 +36,10 @@ class FJFXMinutiaeQualityFeature : public BaseFeature {
 	    const std::vector<FingerJetFXFeature::Minutia> &minutiaData,
 	    const bool templateCouldBeExtracted);
 
+	FJFXMinutiaeQualityFeature(const ImageAnalysisContext &context,
+	    const std::vector<FingerJetFXFeature::Minutia> &minutiaData,
+	    const bool templateCouldBeExtracted);
+
 	virtual ~FJFXMinutiaeQualityFeature();
 
 	std::string getModuleName() const override;
@@ -49,16 +56,16 @@ class FJFXMinutiaeQualityFeature : public BaseFeature {
 	bool getTemplateStatus() const;
 
     private:
-	std::vector<NFIQ2::QualityFeatureResult> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	void computeFeatureData(
+	    const ImageAnalysisContext &context);
 
 	std::vector<FingerJetFXFeature::Minutia> minutiaData_ {};
 	bool templateCouldBeExtracted_ { false };
 	std::vector<MinutiaData> computeMuMinQuality(
-	    int bs, const NFIQ2::FingerprintImageData &fingerprintImage);
+	    int bs, const IntensityIntegrals &integrals);
 
 	std::vector<MinutiaData> computeOCLMinQuality(
-	    int bs, const NFIQ2::FingerprintImageData &fingerprintImage);
+	    int bs, const GradientIntegrals &gradients);
 
 	double computeMMBBasedOnCOM(int bs,
 	    const NFIQ2::FingerprintImageData &fingerprintImage,
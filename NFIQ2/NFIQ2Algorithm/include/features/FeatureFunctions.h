@@ -27,8 +27,8 @@ double ocl(double a, double b, double c);
 
 uint8_t allfun(const cv::Mat &image);
 
-void getRotatedBlock(const cv::Mat &block, const double orientation,
-    bool padFlag, cv::Mat &rotatedBlock);
+void getRotatedBlockWindow(const cv::Mat &block, const double orientation,
+    bool padFlag, const cv::Rect &window, cv::Mat &rotatedWindow);
 
 void getRidgeValleyStructure(const cv::Mat &blockCropped,
     std::vector<uint8_t> &ridval, std::vector<double> &dt);
@@ -48,10 +48,15 @@ void computeNumericalGradients(
 void addSamplingFeatures(
     std::vector<NFIQ2::QualityFeatureResult> &featureDataList,
     std::string featurePrefix, std::vector<double> &dataVector);
-void addHistogramFeatures(
-    std::vector<NFIQ2::QualityFeatureResult> &featureDataList,
-    std::string featurePrefix, std::vector<double> &binBoundaries,
-    std::vector<double> &dataVector, int binCount);
+/**
+ * @return
+ * number of values in each of the binCount bins, then their mean and
+ * standard deviation, in the order of addHistogramFeatureNames().
+ * dataVector is sorted.
+ */
+std::vector<double> computeHistogramFeatures(const std::string &featurePrefix,
+    const std::vector<double> &binBoundaries, std::vector<double> &dataVector,
+    int binCount);
 void addSamplingFeatureNames(
     std::vector<std::string> &featureNames, const char *prefix);
 void addHistogramFeatureNames(
@@ -0,0 +1,78 @@
+#ifndef GRADIENTINTEGRALS_H
+#define GRADIENTINTEGRALS_H
+
+#include <opencv2/core.hpp>
+
+namespace NFIQ2 { namespace QualityFeatures {
+
+/**
+ * Summed-area tables of the products of the numerical gradients of an image,
+ * from which the gradient covariance of any block can be queried without
+ * computing the gradients of the block again.
+ *
+ * @details
+ * The gradients are those of computeNumericalGradients() applied to the block
+ * alone, i.e., centered differences inside the block and one-sided ones on
+ * its first and last row and column. Only the inner pixels of a block have the
+ * same gradients as the image, so those are taken from the tables and the one
+ * pixel wide border of the block is computed from the pixels. The gradients
+ * are half-integers, so all sums are exact and equal to the ones summed block
+ * by block.
+ */
+class GradientIntegrals {
+    public:
+	/** Sums over a block of the products of its gradients. */
+	struct Sums {
+		/** sum of gx * gx */
+		double xx {};
+		/** sum of gy * gy */
+		double yy {};
+		/** sum of gx * gy */
+		double xy {};
+	};
+
+	/**
+	 * @param image
+	 * 8-bit single channel image, whose pixels are referenced and must
+	 * outlive the object.
+	 *
+	 * @throws NFIQ2::Exception
+	 * The image is not of type CV_8UC1.
+	 */
+	explicit GradientIntegrals(const cv::Mat &image);
+	~GradientIntegrals();
+
+	/**
+	 * @param block
+	 * Block of the image.
+	 *
+	 * @return
+	 * Sums of the gradient products of the block, with the gradients
+	 * computed as if the block was a separate image.
+	 *
+	 * @throws NFIQ2::Exception
+	 * The block is empty or not inside the image.
+	 */
+	Sums getBlockSums(const cv::Rect &block) const;
+
+	/** @return image the tables were computed for */
+	const cv::Mat &getImage() const;
+
+    private:
+	cv::Mat image {};
+
+	/**
+	 * Integrals (CV_64F, one row and column larger than the image) of the
+	 * products of twice the centered differences of the image, which are
+	 * integers. Pixels on the border of the image are left out.
+	 */
+	cv::Mat integralXX {};
+	cv::Mat integralYY {};
+	cv::Mat integralXY {};
+};
+
+}}
+
+#endif
+
+/******************************************************************************/
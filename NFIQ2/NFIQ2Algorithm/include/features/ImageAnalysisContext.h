@@ -0,0 +1,129 @@
+#ifndef IMAGEANALYSISCONTEXT_H
+#define IMAGEANALYSISCONTEXT_H
+
+#include <features/GradientIntegrals.h>
+#include <features/IntensityIntegrals.h>
+#include <nfiq2_fingerprintimagedata.hpp>
+#include <opencv2/core.hpp>
+
+#include <memory>
+#include <mutex>
+
+namespace NFIQ2 { namespace QualityFeatures {
+
+/**
+ * Intermediate results derived from one fingerprint image that are needed by
+ * more than one quality feature module. Each result is computed the first
+ * time it is requested and reused afterwards, so a single context can be
+ * handed to every module computing features of the same image.
+ *
+ * @note The context does not copy the image, which must outlive it.
+ */
+class ImageAnalysisContext {
+    public:
+	struct BlockOrientationField {
+		/** size of the square blocks in pixels */
+		int blockSize {};
+		/**
+		 * border left around the image so that the window of each
+		 * block fully covers the rotated slanted block
+		 */
+		int blockOffset {};
+		/** covariance coefficient a of each block (CV_64F) */
+		cv::Mat covA {};
+		/** covariance coefficient b of each block (CV_64F) */
+		cv::Mat covB {};
+		/** covariance coefficient c of each block (CV_64F) */
+		cv::Mat covC {};
+		/** ridge orientation of each block in radians (CV_64F) */
+		cv::Mat orientation {};
+		/**
+		 * 1 if the block lies completely inside the segmentation
+		 * mask, 0 otherwise (CV_8UC1)
+		 */
+		cv::Mat mask {};
+	};
+
+	/**
+	 * @param fingerprintImage
+	 * Image to analyze.
+	 * @param threadCount
+	 * Number of threads that loops over the blocks of the image may
+	 * use, 0 for the number of hardware threads.
+	 */
+	ImageAnalysisContext(
+	    const NFIQ2::FingerprintImageData &fingerprintImage,
+	    unsigned int threadCount = 1);
+	~ImageAnalysisContext();
+
+	ImageAnalysisContext(const ImageAnalysisContext &) = delete;
+	ImageAnalysisContext &operator=(const ImageAnalysisContext &) = delete;
+
+	/** @return image the context was created for */
+	const NFIQ2::FingerprintImageData &getFingerprintImage() const;
+
+	/** @return 8-bit matrix referencing the pixels of the image */
+	const cv::Mat &getImage() const;
+
+	/** @return number of threads block loops may use (0 = hardware) */
+	unsigned int getThreadCount() const;
+
+	/**
+	 * @return ridge segmentation mask as computed by ridgesegment() with
+	 * segmentationBlockSize and segmentationThreshold
+	 */
+	const cv::Mat &getSegmentationMask() const;
+
+	/**
+	 * @return orientation of the segmentationBlockSize blocks traversed
+	 * by the slanted block modules, with gradients computed using
+	 * centered differences
+	 */
+	const BlockOrientationField &getBlockOrientationField() const;
+
+	/**
+	 * @return summed-area tables of the gradient products of the image,
+	 * giving the gradient covariance of any block of it
+	 */
+	const GradientIntegrals &getGradientIntegrals() const;
+
+	/**
+	 * @return summed-area tables of the pixels of the image and their
+	 * squares, giving the mean and standard deviation of any block of it
+	 */
+	const IntensityIntegrals &getIntensityIntegrals() const;
+
+	/** block size used for the shared ridge segmentation */
+	static const int segmentationBlockSize;
+	/** threshold used for the shared ridge segmentation */
+	static const double segmentationThreshold;
+	/** width of the slanted block extracted from each oriented block */
+	static const int slantedBlockSizeX;
+	/** height of the slanted block extracted from each oriented block */
+	static const int slantedBlockSizeY;
+
+    private:
+	const NFIQ2::FingerprintImageData &fingerprintImage;
+	const unsigned int threadCount;
+	cv::Mat image {};
+
+	mutable std::once_flag segmentationMaskFlag {};
+	mutable cv::Mat segmentationMask {};
+
+	mutable std::once_flag blockOrientationFieldFlag {};
+	mutable BlockOrientationField blockOrientationField {};
+
+	mutable std::once_flag gradientIntegralsFlag {};
+	mutable std::unique_ptr<GradientIntegrals> gradientIntegrals {};
+
+	mutable std::once_flag intensityIntegralsFlag {};
+	mutable std::unique_ptr<IntensityIntegrals> intensityIntegrals {};
+
+	void computeBlockOrientationField() const;
+};
+
+}}
+
+#endif
+
+/******************************************************************************/
@@ -2,6 +2,7 @@
 #define IMGPROCROIFEATURE_H
 
 #include <features/BaseFeature.h>
+#include <features/ImageAnalysisContext.h>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 #include <opencv2/core.hpp>
@@ -25,6 +26,12 @@ class ImgProcROIFeature : public BaseFeature {
 		unsigned int noOfAllBlocks {};
 		/** detected ROI blocks with position and size */
 		std::vector<cv::Rect> vecROIBlocks {};
+		/**
+		 * 1 for the blocks of the chosenBlockSize grid that are ROI
+		 * blocks, 0 otherwise, indexed by block row and column
+		 * (CV_8UC1)
+		 */
+		cv::Mat roiBlockMap {};
 		/** number of ROI pixels detected in the image (not blocks) */
 		unsigned int noOfROIPixels {};
 		/** number of pixels of the image */
@@ -36,6 +43,7 @@ class ImgProcROIFeature : public BaseFeature {
 	};
 
 	ImgProcROIFeature(const NFIQ2::FingerprintImageData &fingerprintImage);
+	ImgProcROIFeature(const ImageAnalysisContext &context);
 	virtual ~ImgProcROIFeature();
 
 	std::string getModuleName() const override;
@@ -44,7 +52,48 @@ class ImgProcROIFeature : public BaseFeature {
 	static const std::string speedFeatureIDGroup;
 	static const std::string moduleName;
 
-	static ImgProcROIResults computeROI(cv::Mat &img, unsigned int bs);
+	/**
+	 * @param img
+	 * Image to segment.
+	 * @param bs
+	 * Size of the ROI blocks in pixels.
+	 * @param threadCount
+	 * Number of threads the segmentation blurs may use, 0 for the
+	 * number of hardware threads.
+	 */
+	static ImgProcROIResults computeROI(
+	    cv::Mat &img, unsigned int bs, unsigned int threadCount = 1);
+
+	/**
+	 * @brief
+	 * Same result as cv::GaussianBlur(src, dst, cv::Size(ksize, ksize),
+	 * 0.0), with the rows split into bands blurred on up to threadCount
+	 * threads.
+	 *
+	 * @details
+	 * An output row only depends on the input rows within ksize / 2 of
+	 * it, and on the image borders. Each band is therefore blurred on a
+	 * copy that includes those rows (or reaches the image border), and
+	 * only its own rows are kept.
+	 *
+	 * With binaryInput (pixels 0 or 255 only), rows whose neighbouring
+	 * rows are all black or all white are not blurred: they get the
+	 * value the blur produces for a uniform neighbourhood of that
+	 * colour.
+	 *
+	 * @param src
+	 * CV_8UC1 image to blur.
+	 * @param dst
+	 * Blurred image.
+	 * @param ksize
+	 * Odd width and height of the Gaussian kernel.
+	 * @param binaryInput
+	 * true if src only contains 0 and 255.
+	 * @param threadCount
+	 * Number of threads to use, 0 for the number of hardware threads.
+	 */
+	static void gaussianBlurRows(const cv::Mat &src, cv::Mat &dst,
+	    int ksize, bool binaryInput, unsigned int threadCount);
 
 	/** @throw NFIQ2::NFIQException
 	 * Img Proc Results could not be computed.
@@ -52,12 +101,12 @@ class ImgProcROIFeature : public BaseFeature {
 	ImgProcROIResults getImgProcResults();
 
     private:
-	std::vector<NFIQ2::QualityFeatureResult> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	void computeFeatureData(
+	    const NFIQ2::FingerprintImageData &fingerprintImage,
+	    unsigned int threadCount);
 
 	ImgProcROIResults imgProcResults_ {};
 	bool imgProcComputed_ { false };
-	static bool isBlackPixelAvailable(cv::Mat &img, cv::Point &point);
 };
 
 }}
@@ -0,0 +1,77 @@
+#ifndef INTENSITYINTEGRALS_H
+#define INTENSITYINTEGRALS_H
+
+#include <opencv2/core.hpp>
+
+namespace NFIQ2 { namespace QualityFeatures {
+
+/**
+ * Summed-area tables of the pixels of an image and of their squares, from
+ * which the mean and standard deviation of any block can be queried without
+ * visiting its pixels again.
+ *
+ * @details
+ * The sums of 8-bit pixels are integers and exact, and the statistics are
+ * derived from them the same way cv::mean() and cv::meanStdDev() derive them
+ * from their own sums.
+ */
+class IntensityIntegrals {
+    public:
+	/**
+	 * @param image
+	 * 8-bit single channel image.
+	 *
+	 * @throws NFIQ2::Exception
+	 * The image is not of type CV_8UC1.
+	 */
+	explicit IntensityIntegrals(const cv::Mat &image);
+	~IntensityIntegrals();
+
+	/**
+	 * @param block
+	 * Block of the image.
+	 *
+	 * @return
+	 * Mean of the pixels of the block, as computed by cv::mean().
+	 *
+	 * @throws NFIQ2::Exception
+	 * The block is empty or not inside the image.
+	 */
+	double getBlockMean(const cv::Rect &block) const;
+
+	/**
+	 * @brief
+	 * Mean and standard deviation of the pixels of a block, as computed by
+	 * cv::meanStdDev().
+	 *
+	 * @param block
+	 * Block of the image.
+	 * @param mean
+	 * Mean of the pixels.
+	 * @param stddev
+	 * Standard deviation of the pixels.
+	 *
+	 * @throws NFIQ2::Exception
+	 * The block is empty or not inside the image.
+	 */
+	void getBlockMeanStdDev(
+	    const cv::Rect &block, double &mean, double &stddev) const;
+
+	/** @return rectangle covering the whole image */
+	cv::Rect getImageRect() const;
+
+    private:
+	/** integral of the pixels (CV_64F) */
+	cv::Mat integral {};
+	/** integral of the squared pixels (CV_64F) */
+	cv::Mat squaredIntegral {};
+
+	void checkBlock(const cv::Rect &block) const;
+	static double blockSum(const cv::Mat &integral, const cv::Rect &block);
+};
+
+}}
+
+#endif
+
+/******************************************************************************/
@@ -2,6 +2,7 @@
 #define LCSFEATURE_H
 
 #include <features/BaseFeature.h>
+#include <features/ImageAnalysisContext.h>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 
@@ -16,6 +17,7 @@ static double LCSHISTLIMITS[9] = { 0, 0.70, 0.74, 0.77, 0.79, 0.81, 0.83, 0.85,
 class LCSFeature : public BaseFeature {
     public:
 	LCSFeature(const NFIQ2::FingerprintImageData &fingerprintImage);
+	LCSFeature(const ImageAnalysisContext &context);
 	virtual ~LCSFeature();
 
 	std::string getModuleName() const override;
@@ -25,11 +27,10 @@ class LCSFeature : public BaseFeature {
 	static const std::string moduleName;
 
     private:
-	std::vector<NFIQ2::QualityFeatureResult> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	void computeFeatureData(
+	    const ImageAnalysisContext &context);
 
 	const int blocksize { 32 };
-	const double threshold { .1 };
 	const int scannerRes { 500 };
 	const bool padFlag { false };
 };
@@ -2,6 +2,7 @@
 #define MUFEATURE_H
 
 #include <features/BaseFeature.h>
+#include <features/ImageAnalysisContext.h>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 
@@ -13,6 +14,7 @@ namespace NFIQ2 { namespace QualityFeatures {
 class MuFeature : public BaseFeature {
     public:
 	MuFeature(const NFIQ2::FingerprintImageData &fingerprintImage);
+	MuFeature(const ImageAnalysisContext &context);
 	virtual ~MuFeature();
 
 	std::string getModuleName() const override;
@@ -27,8 +29,8 @@ class MuFeature : public BaseFeature {
 	static const std::string moduleName;
 
     private:
-	std::vector<NFIQ2::QualityFeatureResult> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	void computeFeatureData(
+	    const ImageAnalysisContext &context);
 
 	bool sigmaComputed { false };
 	double sigma {};
@@ -4,6 +4,8 @@
 #define BS_OCL 32 // block size for OCL
 
 #include <features/BaseFeature.h>
+#include <features/GradientIntegrals.h>
+#include <features/ImageAnalysisContext.h>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 #include <opencv2/core.hpp>
@@ -20,6 +22,7 @@ class OCLHistogramFeature : public BaseFeature {
     public:
 	OCLHistogramFeature(
 	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	OCLHistogramFeature(const ImageAnalysisContext &context);
 	virtual ~OCLHistogramFeature();
 
 	std::string getModuleName() const override;
@@ -31,9 +34,18 @@ class OCLHistogramFeature : public BaseFeature {
 	// compute OCL value of a given block with block size BSxBS
 	static bool getOCLValueOfBlock(const cv::Mat &block, double &ocl);
 
+	// compute OCL value of the BSxBS block of an image whose gradient
+	// integrals are given
+	static bool getOCLValueOfBlock(const GradientIntegrals &gradients,
+	    const cv::Rect &block, double &ocl);
+
     private:
-	std::vector<NFIQ2::QualityFeatureResult> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	void computeFeatureData(
+	    const ImageAnalysisContext &context);
+
+	// compute OCL value from the gradient sums of a BSxBS block
+	static bool getOCLValueOfSums(
+	    const GradientIntegrals::Sums &sums, double &ocl);
 };
 
 }}
@@ -0,0 +1,67 @@
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace NFIQ2 { namespace QualityFeatures {
+
+/**
+ * Calls body(i) for every i in [0, count), distributing the indices over
+ * up to threadCount threads, one of which is the calling thread. The other
+ * threads are kept in a pool across calls. A threadCount of 0 uses the
+ * number of hardware threads. Workers use the floating point mode of the
+ * calling thread. Calls from within a body run sequentially on the thread
+ * of that body, instead of oversubscribing the threads that already run the
+ * enclosing loop.
+ *
+ * body must only write to state owned by index i. Once every index has
+ * been processed, the exception thrown for the lowest index (if any) is
+ * rethrown in the calling thread.
+ */
+void parallelFor(unsigned int count,
+    const std::function<void(unsigned int)> &body,
+    unsigned int threadCount = 0);
+
+/**
+ * @return 1 when called from within a parallelFor() body, otherwise
+ * threadCount, or the number of hardware threads if threadCount is 0
+ */
+unsigned int resolveThreadCount(unsigned int threadCount);
+
+/**
+ * Calls body(i, values) for every i in [0, count) like parallelFor(), where
+ * values is a vector owned by index i that body appends to. Returns the
+ * vectors concatenated in index order, which is the same sequence a
+ * sequential loop appending to a single vector would produce.
+ */
+template <typename T>
+std::vector<T>
+parallelForConcat(const unsigned int count,
+    const std::function<void(unsigned int, std::vector<T> &)> &body,
+    const unsigned int threadCount = 0)
+{
+	std::vector<std::vector<T>> slots(count);
+	parallelFor(
+	    count, [&](unsigned int i) { body(i, slots[i]); }, threadCount);
+
+	std::size_t size = 0;
+	for (const auto &slot : slots) {
+		size += slot.size();
+	}
+
+	std::vector<T> values;
+	values.reserve(size);
+	for (const auto &slot : slots) {
+		values.insert(values.end(), slot.cbegin(), slot.cend());
+	}
+
+	return values;
+}
+
+}}
+
+#endif
+
+/******************************************************************************/
@@ -2,6 +2,8 @@
 #define QUALITYMAPFEATURES_H
 
 #include <features/BaseFeature.h>
+#include <features/GradientIntegrals.h>
+#include <features/ImageAnalysisContext.h>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 #include <opencv2/core.hpp>
@@ -21,6 +23,8 @@ class QualityMapFeatures : public BaseFeature {
     public:
 	QualityMapFeatures(const NFIQ2::FingerprintImageData &fingerprintImage,
 	    const ImgProcROIFeature::ImgProcROIResults &imgProcResults);
+	QualityMapFeatures(const ImageAnalysisContext &context,
+	    const ImgProcROIFeature::ImgProcROIResults &imgProcResults);
 	virtual ~QualityMapFeatures();
 
 	std::string getModuleName() const override;
@@ -33,6 +37,11 @@ class QualityMapFeatures : public BaseFeature {
 	static bool getAngleOfBlock(
 	    const cv::Mat &block, double &angle, double &coherence);
 
+	// compute orientation angle of a block of an image whose gradient
+	// integrals are given
+	static bool getAngleOfBlock(const GradientIntegrals &gradients,
+	    const cv::Rect &block, double &angle, double &coherence);
+
 	// computes low flow value of block
 	static double computeLowFlowBlockValue(const cv::Mat &block);
 
@@ -43,19 +52,26 @@ class QualityMapFeatures : public BaseFeature {
 	    ImgProcROIFeature::ImgProcROIResults &roiResults,
 	    unsigned int &noOfHighFlowBlocks, unsigned int &noOfLowFlowBlocks);
 
-	// compute orientation map
-	static cv::Mat computeOrientationMap(cv::Mat &img, bool bFilterByROI,
-	    double &coherenceSum, double &coherenceRel, unsigned int bs,
-	    ImgProcROIFeature::ImgProcROIResults roiResults);
+	// compute orientation map, or only its coherence values if
+	// bComputeOrientationImage is false (an empty matrix is returned then)
+	static cv::Mat computeOrientationMap(const GradientIntegrals &gradients,
+	    bool bFilterByROI, double &coherenceSum, double &coherenceRel,
+	    unsigned int bs,
+	    const ImgProcROIFeature::ImgProcROIResults &roiResults,
+	    bool bComputeOrientationImage = true);
+
+	// ROI blocks of the bs grid of img, see
+	// ImgProcROIFeature::ImgProcROIResults::roiBlockMap
+	static cv::Mat getROIBlockMap(const cv::Mat &img, unsigned int bs,
+	    const ImgProcROIFeature::ImgProcROIResults &roiResults);
 
-	// static helper functions for numberical gradient computation
-	static cv::Mat computeNumericalGradientX(const cv::Mat &mat);
-	static void computeNumericalGradients(
-	    const cv::Mat &mat, cv::Mat &grad_x, cv::Mat &grad_y);
+	// compute orientation angle from the gradient sums of a block
+	static bool getAngleOfSums(const GradientIntegrals::Sums &sums,
+	    double &angle, double &coherence);
 
     private:
-	std::vector<NFIQ2::QualityFeatureResult> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	void computeFeatureData(
+	    const ImageAnalysisContext &context);
 
 	ImgProcROIFeature::ImgProcROIResults imgProcResults_ {};
 };
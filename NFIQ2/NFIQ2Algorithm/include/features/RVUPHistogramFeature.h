@@ -2,6 +2,7 @@
 #define RVUPHISTOGRAMFEATURE_H
 
 #include <features/BaseFeature.h>
+#include <features/ImageAnalysisContext.h>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 
@@ -16,6 +17,7 @@ class RVUPHistogramFeature : public BaseFeature {
     public:
 	RVUPHistogramFeature(
 	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	RVUPHistogramFeature(const ImageAnalysisContext &context);
 	virtual ~RVUPHistogramFeature();
 
 	std::string getModuleName() const override;
@@ -25,11 +27,10 @@ class RVUPHistogramFeature : public BaseFeature {
 	static const std::string moduleName;
 
     private:
-	std::vector<NFIQ2::QualityFeatureResult> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	void computeFeatureData(
+	    const ImageAnalysisContext &context);
 
 	const int blocksize { 32 };
-	const double threshold { .1 };
 	const int slantedBlockSizeX { 32 };
 	const int slantedBlockSizeY { 16 };
 	const bool padFlag { true };
@@ -14,7 +14,9 @@
 #include <nfiq2_algorithm.hpp>
 #include <nfiq2_data.hpp>
 #include <nfiq2_exception.hpp>
+#include <nfiq2_featurevector.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
+#include <nfiq2_fingerprintimageview.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 #include <nfiq2_modelinfo.hpp>
 #include <nfiq2_qualityfeatures.hpp>
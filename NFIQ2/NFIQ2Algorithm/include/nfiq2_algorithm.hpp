@@ -1,14 +1,18 @@
 #ifndef NFIQ2_ALGORITHM_HPP_
 #define NFIQ2_ALGORITHM_HPP_
 
+#include <nfiq2_featurevector.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
+#include <nfiq2_fingerprintimageview.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 #include <nfiq2_modelinfo.hpp>
 #include <nfiq2_qualityfeatures.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace NFIQ2 {
 
@@ -23,8 +27,8 @@ class Algorithm {
 	 * Default constructor of Algorithm.
 	 *
 	 * @note
-	 * May load from parameters compiled into source code, in which case
-	 * this can be slow.
+	 * May load from parameters compiled into source code, which are
+	 * referenced in place without parsing.
 	 */
 	Algorithm();
 
@@ -33,9 +37,12 @@ class Algorithm {
 	 * Constructor that loads random forest parameters from disk.
 	 *
 	 * @param fileName
-	 * The file path containing the random forest model.
+	 * The file path containing the random forest model, either as OpenCV
+	 * YAML parameters or in the binary format of nfiq2-convert-model,
+	 * which is memory mapped read-only instead of parsed.
 	 * @param fileHash
-	 * The md5 checksum of the provided file.
+	 * The md5 checksum of the YAML parameters, i.e., of the provided
+	 * file or of the file a binary model was converted from.
 	 */
 	Algorithm(const std::string &fileName, const std::string &fileHash);
 
@@ -75,10 +82,69 @@ class Algorithm {
 	 *
 	 * @throw Exception
 	 * Called before random forest parameters were loaded.
+	 *
+	 * @note
+	 * Only the feature values consumed by the random forest are gathered.
+	 * Use QualityFeatures::computeQualityFeatures() instead when feature
+	 * data, speeds, or actionable feedback are needed as well.
 	 */
 	unsigned int computeQualityScore(
 	    const NFIQ2::FingerprintImageData &rawImage) const;
 
+	/**
+	 * @brief
+	 * Computes the quality score from a view of fingerprint image data.
+	 *
+	 * @details
+	 * The viewed pixels are not copied, except for those remaining after
+	 * removing the white frame around the fingerprint. The score is the
+	 * same as for a FingerprintImageData holding the same pixels.
+	 *
+	 * @param rawImage
+	 * View of the fingerprint image.
+	 *
+	 * @return
+	 * Computed quality score.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded.
+	 */
+	unsigned int computeQualityScore(
+	    const NFIQ2::FingerprintImageView &rawImage) const;
+
+	/**
+	 * @brief
+	 * Computes the quality score from the provided fingerprint image data,
+	 * rejecting empty and uniform images before the expensive quality
+	 * modules are computed.
+	 *
+	 * @details
+	 * The Mu module is computed first. If the image is uniform (sigma
+	 * below ActionableQualityFeedbackThreshold::UniformImage) or empty
+	 * (mu above ActionableQualityFeedbackThreshold::
+	 * EmptyImageOrContrastTooLow), no other quality module is computed
+	 * and the score is 0. Otherwise, the score is the one returned by
+	 * computeQualityScore().
+	 *
+	 * @param rawImage
+	 * Fingerprint image.
+	 * @param actionableQualityFeedback
+	 * Set to the actionable quality feedback of the image. When the
+	 * image was rejected, only UniformImage and
+	 * EmptyImageOrContrastTooLow are present.
+	 *
+	 * @return
+	 * Computed quality score.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded.
+	 */
+	unsigned int computeQualityScoreCascaded(
+	    const NFIQ2::FingerprintImageData &rawImage,
+	    std::unordered_map<std::string,
+		NFIQ2::ActionableQualityFeedback> &actionableQualityFeedback)
+	    const;
+
 	/**
 	 * @brief
 	 * Computes the quality score from a vector of extracted BaseFeatures
@@ -116,6 +182,53 @@ class Algorithm {
 	    const std::unordered_map<std::string, NFIQ2::QualityFeatureData>
 		&features) const;
 
+	/**
+	 * @brief
+	 * Computes the quality score from the dense values of the features
+	 * consumed by the random forest.
+	 *
+	 * @param featureVector
+	 * Feature values, as returned by
+	 * NFIQ2::QualityFeatures::getFeatureVector().
+	 *
+	 * @return
+	 * Computed quality score.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded.
+	 */
+	unsigned int computeQualityScore(
+	    const NFIQ2::FeatureVector &featureVector) const;
+
+	/**
+	 * @brief
+	 * Computes the quality scores of many samples of feature values at
+	 * once, e.g., to score stored features again with another model.
+	 *
+	 * @details
+	 * Each tree of the random forest is evaluated for a chunk of samples
+	 * before moving to the next tree. Scores are identical to those of
+	 * computeQualityScore().
+	 *
+	 * @param featureMatrix
+	 * sampleCount contiguous rows of NFIQ2::FeatureVector::Size feature
+	 * values each, ordered as NFIQ2::FeatureIndex.
+	 * @param sampleCount
+	 * Number of rows of featureMatrix.
+	 * @param threadCount
+	 * Number of threads chunks of rows are distributed over, 0 for the
+	 * number of hardware threads.
+	 *
+	 * @return
+	 * Computed quality score of each row.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded.
+	 */
+	std::vector<unsigned int> computeQualityScores(
+	    const double *featureMatrix, std::size_t sampleCount,
+	    unsigned int threadCount = 1) const;
+
 	/**
 	 * @brief
 	 * Obtain MD5 checksum of random forest parameter file loaded.
@@ -0,0 +1,155 @@
+#ifndef NFIQ2_FEATUREVECTOR_HPP_
+#define NFIQ2_FEATUREVECTOR_HPP_
+
+#include <nfiq2_interfacedefinitions.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+namespace NFIQ2 {
+
+/**
+ * Position of each quality feature consumed by the random forest within a
+ * FeatureVector. Enumerators are named after the feature IDs and ordered as
+ * the random forest was trained.
+ */
+enum class FeatureIndex : std::size_t {
+	FDA_Bin10_0,
+	FDA_Bin10_1,
+	FDA_Bin10_2,
+	FDA_Bin10_3,
+	FDA_Bin10_4,
+	FDA_Bin10_5,
+	FDA_Bin10_6,
+	FDA_Bin10_7,
+	FDA_Bin10_8,
+	FDA_Bin10_9,
+	FDA_Bin10_Mean,
+	FDA_Bin10_StdDev,
+	FingerJetFX_MinCount_COMMinRect200x200,
+	FingerJetFX_MinutiaeCount,
+	FJFXPos_Mu_MinutiaeQuality_2,
+	FJFXPos_OCL_MinutiaeQuality_80,
+	ImgProcROIArea_Mean,
+	LCS_Bin10_0,
+	LCS_Bin10_1,
+	LCS_Bin10_2,
+	LCS_Bin10_3,
+	LCS_Bin10_4,
+	LCS_Bin10_5,
+	LCS_Bin10_6,
+	LCS_Bin10_7,
+	LCS_Bin10_8,
+	LCS_Bin10_9,
+	LCS_Bin10_Mean,
+	LCS_Bin10_StdDev,
+	MMB,
+	Mu,
+	OCL_Bin10_0,
+	OCL_Bin10_1,
+	OCL_Bin10_2,
+	OCL_Bin10_3,
+	OCL_Bin10_4,
+	OCL_Bin10_5,
+	OCL_Bin10_6,
+	OCL_Bin10_7,
+	OCL_Bin10_8,
+	OCL_Bin10_9,
+	OCL_Bin10_Mean,
+	OCL_Bin10_StdDev,
+	OF_Bin10_0,
+	OF_Bin10_1,
+	OF_Bin10_2,
+	OF_Bin10_3,
+	OF_Bin10_4,
+	OF_Bin10_5,
+	OF_Bin10_6,
+	OF_Bin10_7,
+	OF_Bin10_8,
+	OF_Bin10_9,
+	OF_Bin10_Mean,
+	OF_Bin10_StdDev,
+	OrientationMap_ROIFilter_CoherenceRel,
+	OrientationMap_ROIFilter_CoherenceSum,
+	RVUP_Bin10_0,
+	RVUP_Bin10_1,
+	RVUP_Bin10_2,
+	RVUP_Bin10_3,
+	RVUP_Bin10_4,
+	RVUP_Bin10_5,
+	RVUP_Bin10_6,
+	RVUP_Bin10_7,
+	RVUP_Bin10_8,
+	RVUP_Bin10_9,
+	RVUP_Bin10_Mean,
+	RVUP_Bin10_StdDev,
+};
+
+/**
+ * Dense values of the quality features consumed by the random forest,
+ * indexed by FeatureIndex.
+ */
+class FeatureVector {
+    public:
+	/** Number of features in the vector */
+	static constexpr std::size_t Size {
+		static_cast<std::size_t>(FeatureIndex::RVUP_Bin10_StdDev) + 1
+	};
+
+	/** Feature values, in FeatureIndex order */
+	std::array<double, Size> values {};
+
+	/** @return value of the feature at index */
+	double &
+	operator[](const FeatureIndex index)
+	{
+		return this->values[static_cast<std::size_t>(index)];
+	}
+
+	/** @return value of the feature at index */
+	const double &
+	operator[](const FeatureIndex index) const
+	{
+		return this->values[static_cast<std::size_t>(index)];
+	}
+
+	/** @return feature IDs of the vector, in FeatureIndex order */
+	static const std::array<std::string, Size> &getFeatureIDs();
+
+	/**
+	 * @brief
+	 * Gather the features of the vector from a map of quality feature
+	 * data.
+	 *
+	 * @param features
+	 * Map of feature ID, quality feature data pairs, which may contain
+	 * features not consumed by the random forest.
+	 *
+	 * @return
+	 * Vector of the features, 0 for data not of type
+	 * e_QualityFeatureDataTypeDouble.
+	 *
+	 * @throw NFIQ2::Exception
+	 * A feature of the vector is missing from the map.
+	 */
+	static FeatureVector fromQualityFeatureData(
+	    const std::unordered_map<std::string, NFIQ2::QualityFeatureData>
+		&features);
+
+	/**
+	 * @brief
+	 * Convert the vector to a map of quality feature data.
+	 *
+	 * @return
+	 * Map of feature ID, quality feature data pairs of type
+	 * e_QualityFeatureDataTypeDouble.
+	 */
+	std::unordered_map<std::string, NFIQ2::QualityFeatureData>
+	toQualityFeatureData() const;
+};
+
+} // namespace NFIQ2
+
+#endif /* NFIQ2_FEATUREVECTOR_HPP_ */
@@ -0,0 +1,87 @@
+#ifndef NFIQ2_FINGERPRINTIMAGEVIEW_HPP_
+#define NFIQ2_FINGERPRINTIMAGEVIEW_HPP_
+
+#include <nfiq2_fingerprintimagedata.hpp>
+
+#include <cstdint>
+
+namespace NFIQ2 {
+
+/**
+ * Non-owning view of a decompressed fingerprint image, canonically encoded as
+ * per ISO/IEC 19794-4:2005, whose rows may be padded.
+ *
+ * @note
+ * The pixels are not copied and must outlive the view.
+ */
+class FingerprintImageView {
+    public:
+	/**
+	 * @brief
+	 * Constructor viewing image data owned by the caller.
+	 *
+	 * @param pData
+	 * Pointer to the first pixel of decompressed 8 bit-per-pixel
+	 * grayscale image data.
+	 * @param imageWidth
+	 * Width of the image in pixels.
+	 * @param imageHeight
+	 * Height of the image in pixels.
+	 * @param rowStride
+	 * Distance in bytes between the first pixels of two consecutive rows,
+	 * at least `imageWidth`.
+	 * @param fingerCode
+	 * Finger position of the fingerprint in the image.
+	 * @param imageDPI
+	 * Resolution of the image in pixels per inch.
+	 *
+	 * @throws NFIQ2::Exception
+	 * `pData` is null or `rowStride` is smaller than `imageWidth`.
+	 */
+	FingerprintImageView(const uint8_t *pData, uint32_t imageWidth,
+	    uint32_t imageHeight, uint32_t rowStride, uint8_t fingerCode,
+	    uint16_t imageDPI);
+
+	/**
+	 * @brief
+	 * Constructor viewing the data of a fingerprint image.
+	 *
+	 * @param fingerprintImage
+	 * Fingerprint image, which must outlive the view.
+	 */
+	explicit FingerprintImageView(
+	    const NFIQ2::FingerprintImageData &fingerprintImage);
+
+	/** Pointer to the first pixel of the image */
+	const uint8_t *m_Data;
+	/** Width of the fingerprint image (in pixels) */
+	uint32_t m_ImageWidth;
+	/** Height of the fingerprint image (in pixels) */
+	uint32_t m_ImageHeight;
+	/** Distance between the first pixels of two rows (in bytes) */
+	uint32_t m_RowStride;
+	/** ISO finger code of the fingerprint in the image */
+	uint8_t m_FingerCode;
+	/** Dots per inch of the fingerprint image */
+	int16_t m_ImageDPI;
+
+	/**
+	 * @brief
+	 * Remove near-white lines around the image.
+	 *
+	 * @details
+	 * The frame is detected on the viewed pixels, and only the pixels
+	 * inside the frame are copied.
+	 *
+	 * @return
+	 * Cropped fingerprint image.
+	 *
+	 * @throws NFIQException
+	 * Error performing the crop, or the image is too small to be processed
+	 * after cropping.
+	 */
+	NFIQ2::FingerprintImageData removeWhiteFrameAroundFingerprint() const;
+};
+} // namespace NFIQ
+
+#endif /* NFIQ2_FINGERPRINTIMAGEVIEW_HPP_ */
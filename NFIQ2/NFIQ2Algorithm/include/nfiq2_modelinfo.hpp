@@ -58,6 +58,10 @@ class ModelInfo {
 	 * @brief
 	 * Obtain the file path of the model.
 	 *
+	 * @details
+	 * The model is either OpenCV YAML parameters or in the binary format
+	 * of nfiq2-convert-model, which is memory mapped when loaded.
+	 *
 	 * @return
 	 * Returns model file path.
 	 */
@@ -67,6 +71,10 @@ class ModelInfo {
 	 * @brief
 	 * Obtain the md5 checksum of the model
 	 *
+	 * @details
+	 * For binary models, this is the checksum of the YAML parameters the
+	 * model was converted from, which the binary model records.
+	 *
 	 * @return
 	 * Returns model md5 checksum.
 	 */
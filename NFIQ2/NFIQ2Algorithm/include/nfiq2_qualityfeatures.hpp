@@ -1,6 +1,7 @@
 #ifndef NFIQ2_QUALITYFEATURES_HPP_
 #define NFIQ2_QUALITYFEATURES_HPP_
 
+#include <nfiq2_featurevector.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 
@@ -13,6 +14,19 @@ namespace NFIQ2 { namespace QualityFeatures {
 /* Forward declaration. */
 class BaseFeature;
 
+/** Scheduling of the quality modules computed for a fingerprint image. */
+enum class ModuleExecution {
+	/** Compute all modules one after another in the calling thread. */
+	Sequential,
+	/**
+	 * Compute modules that do not depend on each other concurrently,
+	 * followed by the modules that depend on their results. Modules
+	 * iterating over blocks of the image also distribute the blocks
+	 * over multiple threads.
+	 */
+	Parallel
+};
+
 /**
  * @brief
  * Obtain all actionable quality feedback identifiers.
@@ -54,6 +68,23 @@ std::vector<std::string> getAllSpeedFeatureGroups();
 std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
 computeQualityFeatures(const NFIQ2::FingerprintImageData &rawImage);
 
+/**
+ * @brief
+ * Obtain computed quality feature data from a fingerprint image.
+ *
+ * @param rawImage
+ * Fingerprint image in raw format.
+ * @param execution
+ * How the quality modules are scheduled. Feature values and the order of
+ * the returned modules do not depend on this parameter.
+ *
+ * @return
+ * A vector if BaseFeature modules containing computed feature data.
+ */
+std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
+computeQualityFeatures(const NFIQ2::FingerprintImageData &rawImage,
+    ModuleExecution execution);
+
 /**
  * @brief
  * Obtain actionable quality feedback from a vector of features.
@@ -110,6 +141,25 @@ getQualityFeatureData(
 std::unordered_map<std::string, NFIQ2::QualityFeatureData>
 getQualityFeatureData(const NFIQ2::FingerprintImageData &rawImage);
 
+/**
+ * @brief
+ * Obtain the features consumed by the random forest from a vector of
+ * features.
+ *
+ * @param features
+ * A vector of BaseFeatures obtained from a raw fingerprint image.
+ *
+ * @return
+ * Dense feature values, copied from the slots set by the modules.
+ *
+ * @throw NFIQ2::Exception
+ * No features or not all quality features have been computed.
+ */
+NFIQ2::FeatureVector
+getFeatureVector(
+    const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
+	&features);
+
 /**
  * @brief
  * Obtain quality feature speeds from a vector of features.
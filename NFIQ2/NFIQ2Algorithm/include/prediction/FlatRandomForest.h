@@ -0,0 +1,253 @@
+#ifndef FLATRANDOMFOREST_H
+#define FLATRANDOMFOREST_H
+
+#include <opencv2/core.hpp>
+#include <opencv2/ml.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace NFIQ2 { namespace Prediction {
+
+/**
+ * Trained random forest converted into flat node arrays, evaluated without
+ * the OpenCV machine learning module.
+ *
+ * @details
+ * Nodes are stored as a structure of arrays. The nodes of each tree are
+ * numbered breadth first, so that the right child of a split immediately
+ * follows its left child and only the offset of the left child is stored.
+ * Leaves have a NaN threshold and their own offset minus one as left child,
+ * so that every sample stays on a leaf once it is reached. Each tree is then
+ * descended for a fixed number of steps, its depth, without testing for
+ * leaves, and several trees are descended at once.
+ *
+ * Evaluation follows cv::ml::RTrees::predict() with
+ * cv::ml::StatModel::RAW_OUTPUT for a two-class forest, i.e., the values of
+ * the leaves reached in every tree are summed, and yields the same result.
+ *
+ * The arrays are only referenced, so that they can be owned by the forest,
+ * memory mapped from a file in the binary format of write(), or compiled
+ * into the library. Copies of a forest share the arrays.
+ */
+class FlatRandomForest {
+    public:
+	/** Arrays of a forest and their sizes. */
+	struct Tables {
+		/** Number of values of a sample */
+		std::size_t featureCount {};
+		/** Number of trees */
+		std::size_t treeCount {};
+		/** Number of nodes of all trees */
+		std::size_t nodeCount {};
+
+		/** Offset of the root of each tree */
+		const int32_t *roots {};
+		/** Number of splits on the longest path of each tree */
+		const int32_t *depths {};
+		/** Feature compared by each node */
+		const int32_t *featureIndices {};
+		/** Split threshold, samples not greater go to the left child */
+		const float *thresholds {};
+		/** Offset of the left child, the right child is the next node */
+		const int32_t *leftChildren {};
+		/** 1 if samples missing the feature go to the right child */
+		const uint8_t *missingRight {};
+		/** Value of each node, used for leaves */
+		const double *values {};
+		/** featureCount values replacing missing features, or null */
+		const float *missingSubstitutes {};
+	};
+
+	/** Identifies files in the binary format. */
+	static const char BinaryMagic[8];
+	/** Version of the binary format written by write(). */
+	static const uint32_t BinaryVersion;
+
+	/** Creates an empty forest. */
+	FlatRandomForest();
+
+	/**
+	 * @brief
+	 * Converts a trained OpenCV forest.
+	 *
+	 * @param trees
+	 * Trained two-class forest with ordered variables only.
+	 * @param parameters
+	 * Node the forest was read from, for the parameters not exposed by
+	 * cv::ml::DTrees.
+	 * @param featureCount
+	 * Number of values of a sample.
+	 *
+	 * @throws NFIQ2::Exception
+	 * The forest is not trained or uses features this class does not
+	 * support.
+	 */
+	FlatRandomForest(const cv::ml::DTrees &trees,
+	    const cv::FileNode &parameters, std::size_t featureCount);
+
+	/**
+	 * @brief
+	 * References existing arrays.
+	 *
+	 * @param tables
+	 * Arrays of the forest.
+	 * @param storage
+	 * Owner of the arrays, kept alive as long as the forest and its
+	 * copies, or null for arrays with static storage duration.
+	 *
+	 * @throws NFIQ2::Exception
+	 * The arrays do not describe a valid forest.
+	 */
+	FlatRandomForest(const Tables &tables,
+	    const std::shared_ptr<const void> &storage);
+
+	/**
+	 * @brief
+	 * References a forest in the binary format written by write().
+	 *
+	 * @param data
+	 * First byte of the forest, aligned to 8 bytes.
+	 * @param size
+	 * Number of bytes of the forest.
+	 * @param storage
+	 * Owner of the bytes, kept alive as long as the forest and its
+	 * copies.
+	 *
+	 * @throws NFIQ2::Exception
+	 * The bytes are not a valid forest in the binary format, e.g., they
+	 * do not match the checksum recorded in the header.
+	 */
+	FlatRandomForest(const void *data, std::size_t size,
+	    const std::shared_ptr<const void> &storage);
+
+	~FlatRandomForest();
+
+	/**
+	 * @brief
+	 * Reads and converts a forest saved by OpenCV.
+	 *
+	 * @param parameters
+	 * YAML written by cv::ml::RTrees, with the forest stored under
+	 * "my_random_trees".
+	 * @param featureCount
+	 * Number of values of a sample.
+	 *
+	 * @throws cv::Exception
+	 * The parameters could not be read.
+	 * @throws NFIQ2::Exception
+	 * The forest could not be converted.
+	 */
+	static FlatRandomForest fromYAML(
+	    const std::string &parameters, std::size_t featureCount);
+
+	/**
+	 * @return
+	 * true if size bytes starting at data begin with BinaryMagic.
+	 */
+	static bool isBinary(const void *data, std::size_t size);
+
+	/**
+	 * @brief
+	 * Writes the forest in the binary format.
+	 *
+	 * @details
+	 * The format is a header followed by the arrays of Tables, each
+	 * aligned to 8 bytes, in the byte order of the writing machine. The
+	 * header records an MD5 checksum of all other bytes, which is
+	 * verified when reading.
+	 *
+	 * @param stream
+	 * Binary stream to write to.
+	 * @param parameterHash
+	 * MD5 checksum of the parameters the forest was read from, recorded
+	 * in the header.
+	 *
+	 * @throws NFIQ2::Exception
+	 * The hash is too long or the stream could not be written.
+	 */
+	void write(std::ostream &stream, const std::string &parameterHash) const;
+
+	/**
+	 * @return
+	 * MD5 checksum recorded in the binary format, empty for forests not
+	 * read from it.
+	 */
+	std::string getParameterHash() const;
+
+	/** @return true if the forest has no trees */
+	bool empty() const;
+
+	/** @return number of values of a sample */
+	std::size_t getFeatureCount() const;
+
+	/** @return arrays of the forest, valid as long as the forest */
+	const Tables &getTables() const;
+
+	/**
+	 * @return
+	 * true if any of the getFeatureCount() values of sample is missing,
+	 * i.e., FLT_MAX as in cv::ml::TrainData.
+	 */
+	bool hasMissingFeatures(const float *sample) const;
+
+	/**
+	 * @brief
+	 * Evaluates the forest for a sample.
+	 *
+	 * @param sample
+	 * getFeatureCount() feature values.
+	 *
+	 * @return
+	 * Sum of the values of the leaves reached in all trees.
+	 */
+	double evaluate(const float *sample) const;
+
+	/**
+	 * @brief
+	 * Evaluates the forest for several samples.
+	 *
+	 * @details
+	 * The trees are visited in the outer loop, so that the nodes of a
+	 * tree stay in cache while all samples pass through it. Sums are
+	 * identical to those of evaluate() for each sample.
+	 *
+	 * @param samples
+	 * sampleCount rows of getFeatureCount() feature values.
+	 * @param sampleCount
+	 * Number of samples.
+	 * @param sums
+	 * sampleCount sums of the values of the leaves reached in all trees.
+	 */
+	void evaluate(const float *samples, std::size_t sampleCount,
+	    double *sums) const;
+
+    private:
+	/** Arrays of the forest */
+	Tables tables {};
+	/** Owner of the arrays */
+	std::shared_ptr<const void> storage {};
+	/** Hash recorded in the binary format */
+	std::string parameterHash {};
+
+	/** @throws NFIQ2::Exception tables do not describe a valid forest */
+	void validate() const;
+
+	/** @return child of a split the sample goes to, or the same leaf */
+	int32_t descend(int32_t node, const float *sample) const;
+
+	/**
+	 * @return
+	 * Value of the leaf reached in the tree starting at root, for samples
+	 * with missing features and no substitutes.
+	 */
+	double evaluateTreeWithMissing(
+	    int32_t root, const float *sample) const;
+};
+
+}}
+
+#endif /* FLATRANDOMFOREST_H */
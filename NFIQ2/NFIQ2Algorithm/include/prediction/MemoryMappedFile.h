@@ -0,0 +1,50 @@
+#ifndef MEMORYMAPPEDFILE_H
+#define MEMORYMAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace NFIQ2 { namespace Prediction {
+
+/**
+ * Read-only view of the contents of a file, mapped into memory so that its
+ * pages are loaded on first access and shared by all processes mapping the
+ * same file.
+ */
+class MemoryMappedFile {
+    public:
+	/**
+	 * @param fileName
+	 * Path of the file to map.
+	 *
+	 * @throws NFIQ2::Exception
+	 * The file could not be opened or mapped.
+	 */
+	explicit MemoryMappedFile(const std::string &fileName);
+	~MemoryMappedFile();
+
+	MemoryMappedFile(const MemoryMappedFile &) = delete;
+	MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+	/**
+	 * @return
+	 * First byte of the file, aligned to the page size, or null for an
+	 * empty file.
+	 */
+	const void *data() const;
+
+	/** @return number of bytes of the file */
+	std::size_t size() const;
+
+    private:
+	const void *address {};
+	std::size_t length {};
+#ifdef _WIN32
+	/** Handle of the file mapping object */
+	void *mapping {};
+#endif
+};
+
+}}
+
+#endif /* MEMORYMAPPEDFILE_H */
@@ -1,9 +1,12 @@
 #ifndef RANDOMFORESTML_H
 #define RANDOMFORESTML_H
 
+#include <nfiq2_featurevector.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
-#include <opencv2/ml.hpp>
+#include <prediction/FlatRandomForest.h>
 
+#include <cstddef>
+#include <ostream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -30,14 +33,32 @@ class RandomForestML {
 	std::string getModuleName() const;
 
 #ifdef NFIQ2_EMBED_RANDOM_FOREST_PARAMETERS
-	/** Initializes module when parameters are embedded. */
+	/**
+	 * Initializes module when parameters are embedded, referencing the
+	 * node arrays generated at build time by nfiq2-embed-model. The
+	 * arrays are validated on the first call only.
+	 */
 	std::string initModule();
 #endif
 
-	/** Initialize model (When not using embedded parameters). */
+	/**
+	 * Initialize model (When not using embedded parameters), either from
+	 * the OpenCV YAML parameters or from the binary format written by
+	 * writeBinary(), which is memory mapped instead of parsed. Returns
+	 * the hash of the YAML parameters, which a binary model records.
+	 */
 	std::string initModule(
 	    const std::string &fileName, const std::string &fileHash);
 
+	/**
+	 * Write the initialized model in the binary format, recording the
+	 * hash of the parameters it was initialized from.
+	 */
+	void writeBinary(std::ostream &stream) const;
+
+	/** Write the initialized model to a file in the binary format. */
+	void writeBinary(const std::string &fileName) const;
+
 	/**
 	 * Compute NFIQ2 quality score based on model and provided
 	 * QualityFeatureData.
@@ -47,18 +68,52 @@ class RandomForestML {
 		&features,
 	    double &qualityValue) const;
 
+	/**
+	 * Compute NFIQ2 quality score based on model and feature values
+	 * ordered as returned by getFeatureOrder().
+	 */
+	void evaluate(const std::vector<double> &featureValues,
+	    double &qualityValue) const;
+
+	/**
+	 * Compute NFIQ2 quality score based on model and the features
+	 * consumed by it.
+	 */
+	void evaluate(const NFIQ2::FeatureVector &featureVector,
+	    double &qualityValue) const;
+
+	/**
+	 * Compute NFIQ2 quality scores of sampleCount rows of
+	 * NFIQ2::FeatureVector::Size feature values, ordered as returned by
+	 * getFeatureOrder(), distributing chunks of rows over threadCount
+	 * threads (0 for the number of hardware threads).
+	 */
+	void evaluate(const double *featureMatrix, std::size_t sampleCount,
+	    std::vector<double> &qualityValues,
+	    unsigned int threadCount = 1) const;
+
+	/**
+	 * Returns the feature IDs consumed by the model, in model order,
+	 * i.e., those of NFIQ2::FeatureVector.
+	 */
+	static const std::vector<std::string> &getFeatureOrder();
+
     private:
-	/** OpenCV shared smart pointer referring to the RF model itself. */
-	cv::Ptr<cv::ml::RTrees> m_pTrainedRF;
+	/** RF model itself, converted from the OpenCV model. */
+	FlatRandomForest m_forest {};
+	/** Hash of the parameters the model was initialized from. */
+	std::string m_parameterHash {};
+	/**
+	 * Whether samples are evaluated by the code generated from the
+	 * embedded model (EMBED_RANDOM_FOREST_CODE) instead of m_forest.
+	 */
+	bool m_generatedCode { false };
 	/** Calculates the hash of the RandomForest parameters. */
 	std::string calculateHashString(const std::string &s);
 	/** Initialize model using string parameters. */
 	void initModule(const std::string &params);
-
-#ifdef NFIQ2_EMBED_RANDOM_FOREST_PARAMETERS
-	/** Extracts string parameters when model is embedded. */
-	std::string joinRFTrainedParamsString();
-#endif
+	/** Sum of the leaves reached by NFIQ2::FeatureVector::Size values. */
+	double evaluateSample(const float *sample) const;
 };
 
 }}
@@ -1,4 +1,5 @@
 #include <features/BaseFeature.h>
+#include <nfiq2_exception.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 
 #include <vector>
@@ -16,7 +17,38 @@ NFIQ2::QualityFeatures::BaseFeature::getSpeed() const
 std::vector<NFIQ2::QualityFeatureResult>
 NFIQ2::QualityFeatures::BaseFeature::getFeatures() const
 {
-	return this->features;
+	const auto &featureIDs = NFIQ2::FeatureVector::getFeatureIDs();
+
+	std::vector<NFIQ2::QualityFeatureResult> features {};
+	for (std::size_t i = 0; i < NFIQ2::FeatureVector::Size; i++) {
+		if (!this->computedFeatures[i]) {
+			continue;
+		}
+
+		NFIQ2::QualityFeatureResult result {};
+		result.featureData.featureID = featureIDs[i];
+		result.featureData.featureDataType =
+		    NFIQ2::e_QualityFeatureDataTypeDouble;
+		result.featureData.featureDataDouble =
+		    this->featureValues.values[i];
+		result.returnCode = 0;
+		features.push_back(result);
+	}
+
+	return features;
+}
+
+std::size_t
+NFIQ2::QualityFeatures::BaseFeature::copyFeatureValues(
+    NFIQ2::FeatureVector &featureVector) const
+{
+	for (std::size_t i = 0; i < NFIQ2::FeatureVector::Size; i++) {
+		if (this->computedFeatures[i]) {
+			featureVector.values[i] = this->featureValues.values[i];
+		}
+	}
+
+	return this->computedFeatures.count();
 }
 
 void
@@ -26,9 +58,27 @@ NFIQ2::QualityFeatures::BaseFeature::setSpeed(
 	this->speed = featureSpeed;
 }
 
+void
+NFIQ2::QualityFeatures::BaseFeature::setFeature(
+    const NFIQ2::FeatureIndex index, const double value)
+{
+	this->featureValues[index] = value;
+	this->computedFeatures.set(static_cast<std::size_t>(index));
+}
+
 void
 NFIQ2::QualityFeatures::BaseFeature::setFeatures(
-    const std::vector<NFIQ2::QualityFeatureResult> &featureResult)
+    const NFIQ2::FeatureIndex first, const std::vector<double> &values)
 {
-	this->features = featureResult;
+	const std::size_t offset = static_cast<std::size_t>(first);
+	if (offset + values.size() > NFIQ2::FeatureVector::Size) {
+		throw NFIQ2::Exception(
+		    NFIQ2::ErrorCode::FeatureCalculationError,
+		    "Quality features exceed the feature vector");
+	}
+
+	for (std::size_t i = 0; i < values.size(); i++) {
+		this->featureValues.values[offset + i] = values[i];
+		this->computedFeatures.set(offset + i);
+	}
 }
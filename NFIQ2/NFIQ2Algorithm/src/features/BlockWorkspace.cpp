@@ -0,0 +1,97 @@
+#include <features/BlockWorkspace.h>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+/** Workspaces of all running threads and the counts of finished ones. */
+struct WorkspaceRegistry {
+	std::mutex mutex {};
+	std::vector<NFIQ2::QualityFeatures::BlockWorkspace *> workspaces {};
+	NFIQ2::QualityFeatures::BlockWorkspace::Statistics retired {};
+};
+
+WorkspaceRegistry &
+getRegistry()
+{
+	static WorkspaceRegistry registry {};
+	return registry;
+}
+
+}
+
+NFIQ2::QualityFeatures::BlockWorkspace::BlockWorkspace()
+{
+	WorkspaceRegistry &registry = getRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	registry.workspaces.push_back(this);
+}
+
+NFIQ2::QualityFeatures::BlockWorkspace::~BlockWorkspace()
+{
+	WorkspaceRegistry &registry = getRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	registry.workspaces.erase(std::remove(registry.workspaces.begin(),
+				      registry.workspaces.end(), this),
+	    registry.workspaces.end());
+	registry.retired.requests += this->requests.load();
+	registry.retired.allocations += this->allocations.load();
+}
+
+NFIQ2::QualityFeatures::BlockWorkspace &
+NFIQ2::QualityFeatures::BlockWorkspace::forCurrentThread()
+{
+	static thread_local BlockWorkspace workspace {};
+	return workspace;
+}
+
+cv::Mat &
+NFIQ2::QualityFeatures::BlockWorkspace::get(
+    const Buffer buffer, const int rows, const int cols, const int type)
+{
+	cv::Mat &mat = this->buffers[static_cast<std::size_t>(buffer)];
+
+	// only this thread updates the counts, others merely read them
+	this->requests.store(this->requests.load(std::memory_order_relaxed) + 1,
+	    std::memory_order_relaxed);
+	if ((mat.rows != rows) || (mat.cols != cols) || (mat.type() != type)) {
+		this->allocations.store(
+		    this->allocations.load(std::memory_order_relaxed) + 1,
+		    std::memory_order_relaxed);
+		mat.create(rows, cols, type);
+	}
+
+	return mat;
+}
+
+NFIQ2::QualityFeatures::BlockWorkspace::Statistics
+NFIQ2::QualityFeatures::BlockWorkspace::getStatistics()
+{
+	WorkspaceRegistry &registry = getRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	Statistics statistics = registry.retired;
+	for (const auto &workspace : registry.workspaces) {
+		statistics.requests += workspace->requests.load(
+		    std::memory_order_relaxed);
+		statistics.allocations += workspace->allocations.load(
+		    std::memory_order_relaxed);
+	}
+
+	return statistics;
+}
+
+void
+NFIQ2::QualityFeatures::BlockWorkspace::resetStatistics()
+{
+	WorkspaceRegistry &registry = getRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	registry.retired = {};
+	for (const auto &workspace : registry.workspaces) {
+		workspace->requests.store(0, std::memory_order_relaxed);
+		workspace->allocations.store(0, std::memory_order_relaxed);
+	}
+}
@@ -1,5 +1,7 @@
+#include <features/BlockWorkspace.h>
 #include <features/FDAFeature.h>
 #include <features/FeatureFunctions.h>
+#include <features/ParallelFor.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
 #include <opencv2/core.hpp>
@@ -13,7 +15,14 @@ double fda(const cv::Mat &block, const double orientation, const int v1sz_x,
 NFIQ2::QualityFeatures::FDAFeature::FDAFeature(
     const NFIQ2::FingerprintImageData &fingerprintImage)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	const ImageAnalysisContext context(fingerprintImage);
+	computeFeatureData(context);
+}
+
+NFIQ2::QualityFeatures::FDAFeature::FDAFeature(
+    const ImageAnalysisContext &context)
+{
+	computeFeatureData(context);
 }
 
 NFIQ2::QualityFeatures::FDAFeature::~FDAFeature() = default;
@@ -39,23 +48,20 @@ NFIQ2::QualityFeatures::FDAFeature::getModuleName() const
 	return moduleName;
 }
 
-std::vector<NFIQ2::QualityFeatureResult>
+void
 NFIQ2::QualityFeatures::FDAFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const ImageAnalysisContext &context)
 {
-	std::vector<NFIQ2::QualityFeatureResult> featureDataList;
-
 	// check if input image has 500 dpi
-	if (fingerprintImage.m_ImageDPI != NFIQ2::e_ImageResolution_500dpi) {
+	if (context.getFingerprintImage().m_ImageDPI !=
+	    NFIQ2::e_ImageResolution_500dpi) {
 		throw NFIQ2::Exception(
 		    NFIQ2::ErrorCode::FeatureCalculationError,
 		    "Only 500 dpi fingerprint images are supported!");
 	}
 
 	// get matrix from fingerprint image
-	cv::Mat img = cv::Mat(fingerprintImage.m_ImageHeight,
-	    fingerprintImage.m_ImageWidth, CV_8UC1,
-	    (void *)fingerprintImage.data());
+	const cv::Mat &img = context.getImage();
 
 	// ----------------------------
 	// compute Fda (taken from Rvu)
@@ -66,15 +72,12 @@ NFIQ2::QualityFeatures::FDAFeature::computeFeatureData(
 	try {
 		timer.start();
 
-		cv::Mat maskim;
 		const int blksize = this->blocksize;
 		const int v1sz_x = this->slantedBlockSizeX;
 		const int v1sz_y = this->slantedBlockSizeY;
 
-		assert((blksize > 0) && (this->threshold > 0));
-
-		ridgesegment(img, blksize, this->threshold, cv::noArray(),
-		    maskim, cv::noArray());
+		const ImageAnalysisContext::BlockOrientationField &field =
+		    context.getBlockOrientationField();
 
 		int rows = img.rows;
 		int cols = img.cols;
@@ -88,67 +91,55 @@ NFIQ2::QualityFeatures::FDAFeature::computeFeatureData(
 		int blkoffset = static_cast<int>(
 		    ceil(diff / 2)); // overlapping border
 
+		assert((field.blockSize == blksize) &&
+		    (field.blockOffset == blkoffset));
+
 		int mapRows = static_cast<int>(
 		    (static_cast<double>(rows) - diff) / blk);
 		int mapCols = static_cast<int>(
 		    (static_cast<double>(cols) - diff) / blk);
 
 		cv::Mat fdas = cv::Mat::zeros(mapRows, mapCols, CV_64F);
-		cv::Mat blkorient = cv::Mat::zeros(mapRows, mapCols, CV_64F);
-		cv::Mat im_roi, blkwim;
-		cv::Mat maskB1;
-		double cova, covb, covc;
-
-		std::vector<double> dataVector;
-		dataVector.reserve(mapRows * mapCols);
-
-		// Image processed NOT from beg to end but with a border around
-		// - can't be vectorized:(
-		int br = 0;
-		int bc = 0;
-		for (int r = blkoffset; r < rows - (blksize + blkoffset - 1);
-		     r += blksize) {
-			for (int c = blkoffset;
-			     c < cols - (blksize + blkoffset - 1);
-			     c += blksize) {
-				im_roi = img(
-				    cv::Range(
-					r, cv::min(r + blksize, img.rows)),
-				    cv::Range(
-					c, cv::min(c + blksize, img.cols)));
-				maskB1 = maskim(
-				    cv::Range(
-					r, cv::min(r + blksize, maskim.rows)),
-				    cv::Range(
-					c, cv::min(c + blksize, maskim.cols)));
-				uint8_t mask = allfun(maskB1);
-				if (mask == 1) {
-					covcoef(im_roi, cova, covb, covc,
-					    CENTERED_DIFFERENCES);
-
-					// ridge ORIENT local
-					blkorient.at<double>(br,
-					    bc) = ridgeorient(cova, covb, covc);
-					// overlapping windows (border =
-					// blkoffset)
-					blkwim = img(
-					    cv::Range(r - blkoffset,
-						cv::min(r + blksize + blkoffset,
-						    img.rows)),
-					    cv::Range(c - blkoffset,
-						cv::min(c + blksize + blkoffset,
-						    img.cols)));
-					fdas.at<double>(br, bc) = fda(blkwim,
-					    blkorient.at<double>(br, bc),
-					    v1sz_x, v1sz_y, this->padFlag);
-					dataVector.push_back(
-					    fdas.at<double>(br, bc));
-				}
-				bc = bc + 1;
-			}
-			br = br + 1;
-			bc = 0;
-		}
+
+		// Image processed NOT from beg to end but with a border around.
+		// Block rows are independent and are concatenated in scan
+		// order.
+		std::vector<double> dataVector = parallelForConcat<double>(
+		    static_cast<unsigned int>(mapRows),
+		    [&](unsigned int br, std::vector<double> &rowValues) {
+			    const int r = blkoffset +
+				static_cast<int>(br) * blksize;
+			    cv::Mat blkwim;
+			    int bc = 0;
+			    for (int c = blkoffset;
+				 c < cols - (blksize + blkoffset - 1);
+				 c += blksize) {
+				    uint8_t mask = field.mask.at<uint8_t>(
+					br, bc);
+				    if (mask == 1) {
+					    // overlapping windows (border =
+					    // blkoffset)
+					    blkwim = img(
+						cv::Range(r - blkoffset,
+						    cv::min(r + blksize +
+							    blkoffset,
+							img.rows)),
+						cv::Range(c - blkoffset,
+						    cv::min(c + blksize +
+							    blkoffset,
+							img.cols)));
+					    fdas.at<double>(br, bc) = fda(
+						blkwim,
+						field.orientation.at<double>(
+						    br, bc),
+						v1sz_x, v1sz_y, this->padFlag);
+					    rowValues.push_back(
+						fdas.at<double>(br, bc));
+				    }
+				    bc = bc + 1;
+			    }
+		    },
+		    context.getThreadCount());
 
 		std::vector<double> histogramBins10;
 		histogramBins10.push_back(FDAHISTLIMITS[0]);
@@ -160,8 +151,9 @@ NFIQ2::QualityFeatures::FDAFeature::computeFeatureData(
 		histogramBins10.push_back(FDAHISTLIMITS[6]);
 		histogramBins10.push_back(FDAHISTLIMITS[7]);
 		histogramBins10.push_back(FDAHISTLIMITS[8]);
-		addHistogramFeatures(featureDataList, "FDA_Bin10_",
-		    histogramBins10, dataVector, 10);
+		this->setFeatures(NFIQ2::FeatureIndex::FDA_Bin10_0,
+		    computeHistogramFeatures(
+			"FDA_Bin10_", histogramBins10, dataVector, 10));
 
 		time = timer.stop();
 
@@ -187,8 +179,6 @@ NFIQ2::QualityFeatures::FDAFeature::computeFeatureData(
 		    NFIQ2::ErrorCode::FeatureCalculationError,
 		    "Unknown exception occurred!");
 	}
-
-	return featureDataList;
 }
 
 /**
@@ -233,12 +223,6 @@ fda(const cv::Mat &block, const double orientation, const int v1sz_x,
 		};
 	}
 
-	// rotate image to get the ridges horizontal using nearest-neighbor
-	// interpolation
-	cv::Mat blockRotated;
-	NFIQ2::QualityFeatures::getRotatedBlock(
-	    block, orientation + (M_PI / 2), padFlag, blockRotated);
-
 	//% set x and y
 	int xoff = v1sz_x / 2;
 	int yoff = v1sz_y / 2;
@@ -251,11 +235,24 @@ fda(const cv::Mat &block, const double orientation, const int v1sz_x,
 	// Note: Matlab uses matrix indices starting at 1, OpenCV starts at
 	// 0. Also, OpenCV ranges are open-ended on the upper end.
 
-	cv::Mat blockCropped = blockRotated(
-	    cv::Range((icBlock - (xoff - 1) - 1), (icBlock + xoff)),
-	    cv::Range((icBlock - (yoff - 1) - 1), (icBlock + yoff))); // v2
-
-	cv::Mat t = cv::Mat::zeros(blockCropped.rows, 1, CV_64F);
+	// rotate image to get the ridges horizontal using nearest-neighbor
+	// interpolation, computing only the cropped window
+	const int rowstart = icBlock - (xoff - 1) - 1;
+	const int rowend = icBlock + xoff;
+	const int colstart = icBlock - (yoff - 1) - 1;
+	const int colend = icBlock + yoff;
+	using NFIQ2::QualityFeatures::BlockWorkspace;
+	BlockWorkspace &workspace = BlockWorkspace::forCurrentThread();
+	cv::Mat &blockCropped = workspace.get(
+	    BlockWorkspace::Buffer::RotatedBlock, rowend - rowstart,
+	    colend - colstart, block.type()); // v2
+	NFIQ2::QualityFeatures::getRotatedBlockWindow(block,
+	    orientation + (M_PI / 2), padFlag,
+	    cv::Rect(colstart, rowstart, colend - colstart, rowend - rowstart),
+	    blockCropped);
+
+	cv::Mat &t = workspace.get(
+	    BlockWorkspace::Buffer::RowMeans, blockCropped.rows, 1, CV_64F);
 	for (int r = 0; r < blockCropped.rows; r++) {
 		// get ROI for current row
 		cv::Mat roi = cv::Mat(blockCropped,
@@ -268,15 +265,21 @@ fda(const cv::Mat &block, const double orientation, const int v1sz_x,
 	}
 
 	// compute dft on transposed t (so using transposed dimensions)
-	cv::Mat tmpM;
 	int m = cv::getOptimalDFTSize(t.cols); // t' rows (t cols)
 	int n = cv::getOptimalDFTSize(t.rows); // t' cols (t rows)
 	// create output
-	cv::copyMakeBorder(t.t(), tmpM, 0, m - t.cols, 0, n - t.rows,
-	    cv::BORDER_CONSTANT, cv::Scalar::all(0));
+	cv::Mat &tmpM = workspace.get(
+	    BlockWorkspace::Buffer::SpectrumReal, m, n, CV_64F);
+	// t is a continuous column, so it can be read as a row in place of t'
+	cv::copyMakeBorder(t.reshape(1, 1), tmpM, 0, m - t.cols, 0,
+	    n - t.rows, cv::BORDER_CONSTANT, cv::Scalar::all(0));
 	// copy the source, on the border adding zero values
-	cv::Mat planes[] = { tmpM, cv::Mat::zeros(tmpM.size(), CV_64F) };
-	cv::Mat complex;
+	cv::Mat planes[] = { tmpM,
+		workspace.get(
+		    BlockWorkspace::Buffer::SpectrumImaginary, m, n, CV_64F) };
+	planes[1].setTo(cv::Scalar::all(0));
+	cv::Mat &complex = workspace.get(
+	    BlockWorkspace::Buffer::Spectrum, m, n, CV_64FC2);
 	cv::merge(planes, 2, complex);
 	cv::dft(complex, complex,
 	    cv::DFT_COMPLEX_OUTPUT | cv::DFT_ROWS); // fourier transform
@@ -286,7 +289,10 @@ fda(const cv::Mat &block, const double orientation, const int v1sz_x,
 	cv::split(complex, planes);
 	cv::magnitude(planes[0], planes[1],
 	    planes[0]); // sqrt(Re(DFT(I))^2 + Im(DFT(I))^2)
-	cv::Mat absMag = abs(planes[0]);
+	// same as abs(planes[0]), without allocating the result
+	cv::Mat &absMag = workspace.get(
+	    BlockWorkspace::Buffer::Amplitude, m, n, CV_64F);
+	cv::absdiff(planes[0], cv::Scalar::all(0), absMag);
 	cv::Mat amp(absMag,
 	    cv::Rect(1, 0, absMag.cols - 1, 1)); // set ROI, cutting out DC
 	double mVal;
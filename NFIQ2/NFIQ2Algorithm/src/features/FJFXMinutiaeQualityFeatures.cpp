@@ -12,7 +12,18 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::FJFXMinutiaeQualityFeature(
     : minutiaData_ { minutiaData }
     , templateCouldBeExtracted_ { templateCouldBeExtracted }
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	const ImageAnalysisContext context(fingerprintImage);
+	computeFeatureData(context);
+};
+
+NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::FJFXMinutiaeQualityFeature(
+    const ImageAnalysisContext &context,
+    const std::vector<FingerJetFXFeature::Minutia> &minutiaData,
+    const bool templateCouldBeExtracted)
+    : minutiaData_ { minutiaData }
+    , templateCouldBeExtracted_ { templateCouldBeExtracted }
+{
+	computeFeatureData(context);
 };
 
 NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::
@@ -40,36 +51,15 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::getTemplateStatus() const
 	return (this->templateCouldBeExtracted_);
 }
 
-std::vector<NFIQ2::QualityFeatureResult>
+void
 NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const ImageAnalysisContext &context)
 {
-	std::vector<NFIQ2::QualityFeatureResult> featureDataList;
-
-	NFIQ2::QualityFeatureData fd_mu;
-	fd_mu.featureID = "FJFXPos_Mu_MinutiaeQuality_2";
-	fd_mu.featureDataType = NFIQ2::e_QualityFeatureDataTypeDouble;
-	fd_mu.featureDataDouble = -1;
-	NFIQ2::QualityFeatureResult res_mu;
-	res_mu.featureData = fd_mu;
-	res_mu.returnCode = 0;
-
-	NFIQ2::QualityFeatureData fd_ocl;
-	fd_ocl.featureID = "FJFXPos_OCL_MinutiaeQuality_80";
-	fd_ocl.featureDataType = NFIQ2::e_QualityFeatureDataTypeDouble;
-	fd_ocl.featureDataDouble = -1;
-	NFIQ2::QualityFeatureResult res_ocl;
-	res_ocl.featureData = fd_ocl;
-	res_ocl.returnCode = 0;
-
 	if (!this->templateCouldBeExtracted_) {
-		res_mu.featureData.featureDataDouble = -1;
-		res_mu.returnCode = 0;
-		featureDataList.push_back(res_mu);
-
-		res_ocl.featureData.featureDataDouble = -1;
-		res_ocl.returnCode = 0;
-		featureDataList.push_back(res_ocl);
+		this->setFeature(
+		    NFIQ2::FeatureIndex::FJFXPos_Mu_MinutiaeQuality_2, -1);
+		this->setFeature(
+		    NFIQ2::FeatureIndex::FJFXPos_OCL_MinutiaeQuality_80, -1);
 
 		// Speed
 		NFIQ2::QualityFeatureSpeed speed;
@@ -80,7 +70,7 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeFeatureData(
 		speed.featureSpeed = 0;
 		this->setSpeed(speed);
 
-		return featureDataList;
+		return;
 	}
 
 	try {
@@ -90,7 +80,7 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeFeatureData(
 		// compute minutiae quality based on Mu feature computated at
 		// minutiae positions
 		std::vector<MinutiaData> vecMuMinQualityData =
-		    computeMuMinQuality(32, fingerprintImage);
+		    computeMuMinQuality(32, context.getIntensityIntegrals());
 
 		std::vector<unsigned int> vecRanges(
 		    4); // index 0 = -1 .. -0.5, ....
@@ -113,16 +103,17 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeFeatureData(
 		}
 
 		// return mu_2 quality value
-		res_mu.returnCode = 0;
 		// return relative value in relation to minutiae count
-		res_mu.featureData.featureDataDouble = (double)vecRanges.at(2) /
-		    (double)this->minutiaData_.size();
-		featureDataList.push_back(res_mu);
+		this->setFeature(
+		    NFIQ2::FeatureIndex::FJFXPos_Mu_MinutiaeQuality_2,
+		    (double)vecRanges.at(2) /
+			(double)this->minutiaData_.size());
 
 		// compute minutiae quality based on OCL feature computed at
 		// minutiae positions
 		std::vector<MinutiaData> vecOCLMinQualityData =
-		    computeOCLMinQuality(BS_OCL, fingerprintImage);
+		    computeOCLMinQuality(
+			BS_OCL, context.getGradientIntegrals());
 
 		std::vector<unsigned int> vecRangesOCL(
 		    5); // index 0 = 0-20, 1 = 20-40, ..., 5 = 80-100
@@ -147,12 +138,11 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeFeatureData(
 			}
 		}
 
-		res_ocl.returnCode = 0;
 		// return relative value in relation to minutiae count
-		res_ocl.featureData.featureDataDouble = (double)vecRangesOCL.at(
-							    4) /
-		    (double)this->minutiaData_.size();
-		featureDataList.push_back(res_ocl);
+		this->setFeature(
+		    NFIQ2::FeatureIndex::FJFXPos_OCL_MinutiaeQuality_80,
+		    (double)vecRangesOCL.at(4) /
+			(double)this->minutiaData_.size());
 
 		// Speed
 		NFIQ2::QualityFeatureSpeed speed;
@@ -176,8 +166,6 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeFeatureData(
 		    NFIQ2::ErrorCode::FeatureCalculationError,
 		    "Unknown exception occurred!");
 	}
-
-	return featureDataList;
 }
 
 const std::string
@@ -201,19 +189,16 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::getAllFeatureIDs()
 
 std::vector<NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::MinutiaData>
 NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeMuMinQuality(
-    int bs, const NFIQ2::FingerprintImageData &fingerprintImage)
+    int bs, const IntensityIntegrals &integrals)
 {
 	std::vector<MinutiaData> vecMinData;
 
-	// get matrix from fingerprint image
-	cv::Mat img = cv::Mat(fingerprintImage.m_ImageHeight,
-	    fingerprintImage.m_ImageWidth, CV_8UC1,
-	    (void *)fingerprintImage.data());
+	const cv::Rect imageRect = integrals.getImageRect();
 
 	// compute overall mean and stddev
-	cv::Scalar me;
-	cv::Scalar stddev;
-	cv::meanStdDev(img, me, stddev);
+	double me = 0.0;
+	double stddev = 0.0;
+	integrals.getBlockMeanStdDev(imageRect, me, stddev);
 
 	// iterate through all minutiae positions and
 	// compute own minutiae quality values
@@ -235,18 +220,17 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeMuMinQuality(
 
 		unsigned int takenBS_X = bs;
 		unsigned int takenBS_Y = bs;
-		if ((leftX + bs) > (int)fingerprintImage.m_ImageWidth) {
-			takenBS_X = (fingerprintImage.m_ImageWidth - leftX);
+		if ((leftX + bs) > imageRect.width) {
+			takenBS_X = (imageRect.width - leftX);
 		}
-		if ((topY + bs) > (int)fingerprintImage.m_ImageHeight) {
-			takenBS_Y = (fingerprintImage.m_ImageHeight - topY);
+		if ((topY + bs) > imageRect.height) {
+			takenBS_Y = (imageRect.height - topY);
 		}
 
-		cv::Mat block = img(
+		const double m = integrals.getBlockMean(
 		    cv::Rect(leftX, topY, takenBS_X, takenBS_Y));
-		cv::Scalar m = mean(block);
 		// use normalization of mean and stddev of overall image
-		minData.quality = ((me.val[0] - m.val[0]) / stddev.val[0]);
+		minData.quality = ((me - m) / stddev);
 
 		vecMinData.push_back(minData);
 	}
@@ -256,14 +240,11 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeMuMinQuality(
 
 std::vector<NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::MinutiaData>
 NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeOCLMinQuality(
-    int bs, const NFIQ2::FingerprintImageData &fingerprintImage)
+    int bs, const GradientIntegrals &gradients)
 {
 	std::vector<MinutiaData> vecMinData;
 
-	// get matrix from fingerprint image
-	cv::Mat img = cv::Mat(fingerprintImage.m_ImageHeight,
-	    fingerprintImage.m_ImageWidth, CV_8UC1,
-	    (void *)fingerprintImage.data());
+	const cv::Mat &img = gradients.getImage();
 
 	// iterate through all minutiae positions and
 	// compute own minutiae quality values
@@ -286,20 +267,19 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeOCLMinQuality(
 		// always take full blocks centered around minutiae location
 		// if in edge reason -> don't center around minutiae but take
 		// full block that is closest
-		if ((leftX + bs) > (int)fingerprintImage.m_ImageWidth) {
-			leftX = (fingerprintImage.m_ImageWidth - bs);
+		if ((leftX + bs) > img.cols) {
+			leftX = (img.cols - bs);
 		}
-		if ((topY + bs) > (int)fingerprintImage.m_ImageHeight) {
-			topY = (fingerprintImage.m_ImageHeight - bs);
+		if ((topY + bs) > img.rows) {
+			topY = (img.rows - bs);
 		}
 
-		cv::Mat block = img(cv::Rect(leftX, topY, bs, bs));
-
 		// get OCL value of block
 		// ignore return value as if false is returned OCL value is 0
 		// anyway
 		double ocl = 0.0;
-		OCLHistogramFeature::getOCLValueOfBlock(block, ocl);
+		OCLHistogramFeature::getOCLValueOfBlock(
+		    gradients, cv::Rect(leftX, topY, bs, bs), ocl);
 
 		// assign minutiae quality value
 		// in range 0 (worst) - 100 (best)
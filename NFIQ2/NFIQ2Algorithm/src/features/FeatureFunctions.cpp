@@ -1,10 +1,13 @@
+#include <features/BlockWorkspace.h>
 #include <features/FeatureFunctions.h>
 #include <nfiq2_exception.hpp>
 #include <opencv2/imgproc.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <limits>
+#include <unordered_map>
 
 static const int maxSampleCount = 50;
 
@@ -124,6 +127,63 @@ gradients inside %   a block specified as a parameter
 %   c         - param c of covariance matix [a c; c b]
 %
 ***/
+/*
+Fused equivalent of covcoef() with CENTERED_DIFFERENCES for 8-bit blocks of at
+least 2x2 pixels. Twice the gradients are integers, so the sums of their
+products are accumulated exactly in integer arithmetic, in a single pass and
+without temporary matrices. The double pipeline sums values that are multiples
+of 0.25 and small enough to be represented exactly as well, so scaling the
+integer sums by 0.25 and then by 1/n, as cv::mean() does, yields the same a, b
+and c bit for bit.
+*/
+static void
+covcoefCenteredDifferences8U(
+    const cv::Mat &imblock, double &a, double &b, double &c)
+{
+	const int rows = imblock.rows;
+	const int cols = imblock.cols;
+
+	int64_t sumXX = 0, sumYY = 0, sumXY = 0;
+	for (int r = 0; r < rows; r++) {
+		const uint8_t *row = imblock.ptr<uint8_t>(r);
+		/* forward differences on the first and last rows */
+		const uint8_t *prev = imblock.ptr<uint8_t>(r > 0 ? r - 1 : 0);
+		const uint8_t *next = imblock.ptr<uint8_t>(
+		    r < rows - 1 ? r + 1 : rows - 1);
+		const int32_t yScale = (r == 0 || r == rows - 1) ? 2 : 1;
+
+		/* first column: forward difference */
+		int32_t gx = 2 * (row[1] - row[0]);
+		int32_t gy = yScale * (next[0] - prev[0]);
+		int64_t rowXX = gx * gx, rowYY = gy * gy, rowXY = gx * gy;
+
+		/* central differences, vectorizable */
+		for (int col = 1; col < cols - 1; col++) {
+			const int32_t x = row[col + 1] - row[col - 1];
+			const int32_t y = yScale * (next[col] - prev[col]);
+			rowXX += x * x;
+			rowYY += y * y;
+			rowXY += x * y;
+		}
+
+		/* last column: backward difference */
+		gx = 2 * (row[cols - 1] - row[cols - 2]);
+		gy = yScale * (next[cols - 1] - prev[cols - 1]);
+		rowXX += gx * gx;
+		rowYY += gy * gy;
+		rowXY += gx * gy;
+
+		sumXX += rowXX;
+		sumYY += rowYY;
+		sumXY += rowXY;
+	}
+
+	const double inverseCount = 1. / (rows * cols);
+	a = (static_cast<double>(sumXX) * 0.25) * inverseCount;
+	b = (static_cast<double>(sumYY) * 0.25) * inverseCount;
+	c = (static_cast<double>(sumXY) * 0.25) * inverseCount;
+}
+
 void
 NFIQ2::QualityFeatures::covcoef(const cv::Mat &imblock, double &a, double &b,
     double &c, ocl_type compMethod)
@@ -144,8 +204,22 @@ NFIQ2::QualityFeatures::covcoef(const cv::Mat &imblock, double &a, double &b,
 	comMethod parameter controls which gradient estimation method is used.
 	***/
 
-	cv::Mat dfx, dfy, dfxT;
-	cv::Mat doubleIm;
+	if (compMethod == CENTERED_DIFFERENCES && imblock.type() == CV_8UC1 &&
+	    imblock.rows >= 2 && imblock.cols >= 2) {
+		covcoefCenteredDifferences8U(imblock, a, b, c);
+		return;
+	}
+
+	BlockWorkspace &workspace = BlockWorkspace::forCurrentThread();
+	const int rows = imblock.rows;
+	const int cols = imblock.cols;
+
+	cv::Mat &doubleIm = workspace.get(
+	    BlockWorkspace::Buffer::DoubleBlock, rows, cols, CV_64F);
+	cv::Mat &dfx = workspace.get(
+	    BlockWorkspace::Buffer::GradientX, rows, cols, CV_64F);
+	cv::Mat &dfy = workspace.get(
+	    BlockWorkspace::Buffer::GradientY, rows, cols, CV_64F);
 
 	imblock.convertTo(doubleIm, CV_64F);
 
@@ -154,8 +228,15 @@ NFIQ2::QualityFeatures::covcoef(const cv::Mat &imblock, double &a, double &b,
 		diffGrad(doubleIm, dfy);
 		/* estimate the gradient in the x direction (across the columns)
 		 * by transposing the matrix */
-		diffGrad(doubleIm.t(), dfxT);
-		dfx = dfxT.t();
+		cv::Mat &doubleImT = workspace.get(
+		    BlockWorkspace::Buffer::TransposedBlock, cols, rows,
+		    CV_64F);
+		cv::Mat &dfxT = workspace.get(
+		    BlockWorkspace::Buffer::TransposedGradientX, cols, rows,
+		    CV_64F);
+		cv::transpose(doubleIm, doubleImT);
+		diffGrad(doubleImT, dfxT);
+		cv::transpose(dfxT, dfx);
 	} else // Sobel operator
 	{
 		try {
@@ -179,16 +260,22 @@ NFIQ2::QualityFeatures::covcoef(const cv::Mat &imblock, double &a, double &b,
 	b = mean(fy(:).^2);
 	*/
 	cv::Scalar fxMean, fyMean, ProdMean;
-	cv::Mat dfx2 = dfx.mul(dfx);
+	cv::Mat &dfx2 = workspace.get(
+	    BlockWorkspace::Buffer::GradientXSquared, rows, cols, CV_64F);
+	cv::multiply(dfx, dfx, dfx2);
 	fxMean = cv::mean(dfx2);
-	cv::Mat dfy2 = dfy.mul(dfy);
+	cv::Mat &dfy2 = workspace.get(
+	    BlockWorkspace::Buffer::GradientYSquared, rows, cols, CV_64F);
+	cv::multiply(dfy, dfy, dfy2);
 	fyMean = cv::mean(dfy2);
 
 	a = fxMean.val[0];
 	b = fyMean.val[0];
 
 	/*Matlab: c = fx.*fy; c = mean(c(:)); (Per-element multiplication) */
-	cv::Mat gradProd = dfx.mul(dfy);
+	cv::Mat &gradProd = workspace.get(
+	    BlockWorkspace::Buffer::GradientProduct, rows, cols, CV_64F);
+	cv::multiply(dfx, dfy, gradProd);
 	ProdMean = cv::mean(gradProd);
 	c = ProdMean.val[0];
 
@@ -286,13 +373,21 @@ NFIQ2::QualityFeatures::diffGrad(const cv::Mat &inBlock, cv::Mat &outBlock)
 }
 
 //////////////////////////////////////////////////////////////
+/* Computes the pixels of the rotated (and optionally padded) block that lie
+inside window only, window being given in coordinates of the padded block.
+Matlab: blockRotated = imrotate(block, rad2deg(orientation), 'nearest',
+'crop'); OpenCV's cv::warpAffine() with INTER_NEAREST was used to implement
+it. Each output pixel is gathered from the source pixel that warpAffine
+selects, using its inverse mapping with fixed-point coordinates (10
+fractional bits, rounded to nearest), so the result is identical without
+padding and rotating the whole block.
+*/
 void
-NFIQ2::QualityFeatures::getRotatedBlock(const cv::Mat &block,
-    const double orientation, bool padFlag, cv::Mat &rotatedBlock)
+NFIQ2::QualityFeatures::getRotatedBlockWindow(const cv::Mat &block,
+    const double orientation, bool padFlag, const cv::Rect &window,
+    cv::Mat &rotatedWindow)
 {
 	const double Rad2Deg = 180.0 / M_PI;
-	cv::Mat rot_mat(2, 3, CV_64F);
-	cv::Mat Inblock;
 
 	// sanity check: check block size
 	float cBlock = static_cast<float>(block.rows) / 2; // square block
@@ -305,33 +400,87 @@ NFIQ2::QualityFeatures::getRotatedBlock(const cv::Mat &block,
 			    std::to_string(block.rows) + ')'
 		};
 	}
-
-	if (padFlag) {
-		cv::copyMakeBorder(
-		    block, Inblock, 2, 2, 2, 2, cv::BORDER_CONSTANT, 0);
-	} else {
-		Inblock = block;
+	if ((window.x < 0) || (window.y < 0) || (window.width <= 0) ||
+	    (window.height <= 0) || (window.x + window.width > block.cols) ||
+	    (window.y + window.height > block.rows)) {
+		throw NFIQ2::Exception {
+			NFIQ2::ErrorCode::FeatureCalculationError,
+			"Window of the rotated block exceeds the block"
+		};
 	}
-	try {
-		// rotate image to get the ridges vertical
-		//   Matlab:  blockRotated = imrotate(block,
-		//   rad2deg(orientation), 'nearest', 'crop');
-		rotatedBlock.create(block.rows, block.cols, block.type());
-		double orientDegrees = orientation * Rad2Deg;
-		cv::Point2f center(
-		    ((float)Inblock.cols / 2.0f), ((float)Inblock.rows / 2.0f));
-		rot_mat = getRotationMatrix2D(center, orientDegrees, 1);
-		cv::warpAffine(Inblock, rotatedBlock, rot_mat,
-		    rotatedBlock.size(), cv::INTER_NEAREST);
-	} catch (const cv::Exception &e) {
-		std::stringstream ssErr;
-		ssErr << "Exception during block rotation: " << e.what();
-		throw NFIQ2::Exception(
-		    NFIQ2::ErrorCode::FeatureCalculationError, ssErr.str());
+
+	// the padded block is only implied: its border is zero, just like
+	// the pixels mapped from outside of it
+	const int pad = padFlag ? 2 : 0;
+	double orientDegrees = orientation * Rad2Deg;
+	cv::Point2f center(((float)(block.cols + 2 * pad) / 2.0f),
+	    ((float)(block.rows + 2 * pad) / 2.0f));
+
+	// same as cv::getRotationMatrix2D(center, orientDegrees, 1)
+	const double angle = orientDegrees * CV_PI / 180;
+	const double alpha = std::cos(angle);
+	const double beta = std::sin(angle);
+	double M[6] = { alpha, beta, (1 - alpha) * center.x - beta * center.y,
+		-beta, alpha, beta * center.x + (1 - alpha) * center.y };
+
+	// inverse mapping, as computed by cv::warpAffine()
+	double D = M[0] * M[4] - M[1] * M[3];
+	D = D != 0 ? 1. / D : 0;
+	double A11 = M[4] * D, A22 = M[0] * D;
+	M[0] = A11;
+	M[1] *= -D;
+	M[3] *= -D;
+	M[4] = A22;
+	double b1 = -M[0] * M[2] - M[1] * M[5];
+	double b2 = -M[3] * M[2] - M[4] * M[5];
+	M[2] = b1;
+	M[5] = b2;
+
+	const int fractionBits = 10;
+	const int fractionScale = 1 << fractionBits;
+	const int roundDelta = fractionScale / 2;
+
+	// per column source offsets, shared by all rows of the window
+	cv::Mat &columnOffsets = BlockWorkspace::forCurrentThread().get(
+	    BlockWorkspace::Buffer::RotationColumnOffsets, 2, window.width,
+	    CV_32S);
+	int32_t *xDelta = columnOffsets.ptr<int32_t>(0);
+	int32_t *yDelta = columnOffsets.ptr<int32_t>(1);
+	for (int i = 0; i < window.width; i++) {
+		const int x = window.x + i;
+		xDelta[i] = cv::saturate_cast<int>(M[0] * x * fractionScale);
+		yDelta[i] = cv::saturate_cast<int>(M[3] * x * fractionScale);
 	}
 
-	return;
+	rotatedWindow.create(window.height, window.width, block.type());
+	const size_t pixelSize = block.elemSize();
+	for (int j = 0; j < window.height; j++) {
+		const int y = window.y + j;
+		const int x0 = cv::saturate_cast<int>(
+				   (M[1] * y + M[2]) * fractionScale) +
+		    roundDelta;
+		const int y0 = cv::saturate_cast<int>(
+				   (M[4] * y + M[5]) * fractionScale) +
+		    roundDelta;
+
+		uint8_t *out = rotatedWindow.ptr<uint8_t>(j);
+		for (int i = 0; i < window.width; i++, out += pixelSize) {
+			const int sx = ((x0 + xDelta[i]) >> fractionBits) - pad;
+			const int sy = ((y0 + yDelta[i]) >> fractionBits) - pad;
+			if ((static_cast<unsigned>(sx) <
+				static_cast<unsigned>(block.cols)) &&
+			    (static_cast<unsigned>(sy) <
+				static_cast<unsigned>(block.rows))) {
+				std::memcpy(out,
+				    block.ptr<uint8_t>(sy) + sx * pixelSize,
+				    pixelSize);
+			} else {
+				std::memset(out, 0, pixelSize);
+			}
+		}
+	}
 }
+
 //////////////////////////////////////////////////////////////////////////////
 void
 NFIQ2::QualityFeatures::getRidgeValleyStructure(const cv::Mat &blockCropped,
@@ -343,14 +492,40 @@ NFIQ2::QualityFeatures::getRidgeValleyStructure(const cv::Mat &blockCropped,
 	//    Note: If A is a matrix, mean(A) treats the columns of A as
 	//    vectors, returning
 	//          a row vector of mean values.
-	cv::Mat v3 = cv::Mat::zeros(blockCropped.cols, 1, CV_64F);
-	cv::Mat blockCol;
-	cv::Scalar colMean;
-	for (int i = 0; i < blockCropped.cols; i++) {
-		// extract a column from blockCropped
-		blockCol = blockCropped.col(i);
-		colMean = cv::mean(blockCol, cv::noArray());
-		v3.at<double>(i, 0) = colMean.val[0];
+	const int n = blockCropped.cols;
+	if (n < 2) {
+		throw NFIQ2::Exception {
+			NFIQ2::ErrorCode::FeatureCalculationError,
+			"Ridge/valley processing needs at least 2 columns "
+			"(block columns = " +
+			    std::to_string(n) + ')'
+		};
+	}
+
+	cv::Mat &v3 = BlockWorkspace::forCurrentThread().get(
+	    BlockWorkspace::Buffer::ColumnMeans, n, 1, CV_64F);
+	double *colMeans = v3.ptr<double>(0);
+	if (blockCropped.type() == CV_8UC1) {
+		// Column sums of 8-bit pixels are exact in double, so one pass
+		// over the rows followed by the scaling cv::mean applies gives
+		// the same means as one cv::mean per column
+		for (int i = 0; i < n; i++) {
+			colMeans[i] = 0;
+		}
+		for (int r = 0; r < blockCropped.rows; r++) {
+			const uint8_t *row = blockCropped.ptr<uint8_t>(r);
+			for (int i = 0; i < n; i++) {
+				colMeans[i] += row[i];
+			}
+		}
+		const double scale = 1. / blockCropped.rows;
+		for (int i = 0; i < n; i++) {
+			colMeans[i] *= scale;
+		}
+	} else {
+		for (int i = 0; i < n; i++) {
+			colMeans[i] = cv::mean(blockCropped.col(i)).val[0];
+		}
 	}
 
 	// %% Linear regression using least square
@@ -361,43 +536,35 @@ NFIQ2::QualityFeatures::getRidgeValleyStructure(const cv::Mat &blockCropped,
 	// % Append a column of ones before dividing to include an intercept,
 	// dt1 = [intercept coefficient]
 	//  dt1 = [ones(length(x),1) x'] \ v3';
-	cv::Mat dttemp(v3.rows, 2, CV_64F);
-	for (int i = 0; i < v3.rows; i++) {
-		dttemp.at<double>(i, 0) = 1;
-		dttemp.at<double>(i, 1) = i + 1;
-	}
-
-	cv::Mat dt1;
-	try {
-		cv::solve(dttemp, v3, dt1, cv::DECOMP_QR);
-	} catch (const cv::Exception &e) {
-		std::stringstream ssErr;
-		ssErr << "Exception during ridge/valley processing: "
-			 "cv::solve(cv::DECOMP_QR) "
-		      << e.what();
-		throw NFIQ2::Exception(
-		    NFIQ2::ErrorCode::FeatureCalculationError, ssErr.str());
+	// Solved in closed form with x centered on its mean, which is exact
+	// for x = 1..n (multiples of 0.5, sum of squares n(n^2-1)/12).
+	const double xMean = (n + 1) / 2.0;
+	const double sxx = (static_cast<double>(n) * n * n - n) / 12;
+	double vSum = 0, sxv = 0;
+	for (int i = 0; i < n; i++) {
+		vSum += colMeans[i];
+		sxv += ((i + 1) - xMean) * colMeans[i];
 	}
+	double slope = sxv / sxx;
+	double intercept = (vSum / n) - (slope * xMean);
 
 	// Round to 10 decimal points to preserve score consistency across
 	// platforms (10^10)
-
-	dt1.forEach<double>([&](double &val, const int *) {
-		val = round(val * 10000000000) / 10000000000;
-	});
+	slope = round(slope * 10000000000) / 10000000000;
+	intercept = round(intercept * 10000000000) / 10000000000;
 
 	//%% Block segmentation into ridge and valley regions
 	//  dt = x*dt1(2) + dt1(1);
 	double tmpx, tmpi;
-	for (int i = 0; i < v3.rows; i++) {
+	for (int i = 0; i < n; i++) {
 		tmpi = static_cast<double>(i + 1);
-		tmpx = tmpi * dt1.at<double>(1, 0) + dt1.at<double>(0, 0);
+		tmpx = tmpi * slope + intercept;
 		dt.push_back(tmpx);
 	}
 	// ridval = (v3 < dt)'; % ridges = 1, valleys = 0
 
 	for (unsigned int i = 0; i < dt.size(); i++) {
-		if (v3.at<double>(i, 0) < dt[i]) {
+		if (colMeans[i] < dt[i]) {
 			ridval.push_back(1);
 		} else {
 			ridval.push_back(0);
@@ -564,15 +731,48 @@ NFIQ2::QualityFeatures::addSamplingFeatures(
 	}
 }
 
-void
-NFIQ2::QualityFeatures::addHistogramFeatures(
-    std::vector<NFIQ2::QualityFeatureResult> &featureDataList,
-    std::string featurePrefix, std::vector<double> &binBoundaries,
-    std::vector<double> &dataVector, int binCount)
+/** @return IDs of each bin, then of the mean and the standard deviation */
+static std::vector<std::string>
+makeHistogramFeatureIDs(const std::string &featurePrefix, const int binCount)
 {
-	binBoundaries.push_back(std::numeric_limits<double>::infinity());
+	std::vector<std::string> featureIDs {};
+	for (int i = 0; i < binCount; i++) {
+		featureIDs.push_back(featurePrefix + std::to_string(i));
+	}
+	featureIDs.push_back(featurePrefix + "Mean");
+	featureIDs.push_back(featurePrefix + "StdDev");
+	return featureIDs;
+}
 
-	const int myBinCount = binBoundaries.size();
+/**
+ * IDs of the features returned by computeHistogramFeatures() for the
+ * histograms of the feature modules, built once.
+ */
+static const std::unordered_map<std::string, std::vector<std::string>> &
+getHistogramFeatureIDTables()
+{
+	static const std::unordered_map<std::string, std::vector<std::string>>
+	    tables = []() {
+		    std::unordered_map<std::string, std::vector<std::string>>
+			featureIDs {};
+		    for (const char *prefix : { "FDA_Bin10_", "LCS_Bin10_",
+			     "OCL_Bin10_", "OF_Bin10_", "RVUP_Bin10_" }) {
+			    featureIDs[prefix] = makeHistogramFeatureIDs(
+				prefix, 10);
+		    }
+		    return featureIDs;
+	    }();
+
+	return tables;
+}
+
+std::vector<double>
+NFIQ2::QualityFeatures::computeHistogramFeatures(
+    const std::string &featurePrefix, const std::vector<double> &binBoundaries,
+    std::vector<double> &dataVector, int binCount)
+{
+	// the last bin has no upper boundary
+	const int myBinCount = binBoundaries.size() + 1;
 
 	if (myBinCount != binCount) {
 		std::stringstream s;
@@ -581,71 +781,33 @@ NFIQ2::QualityFeatures::addHistogramFeatures(
 		throw NFIQ2::Exception(
 		    NFIQ2::ErrorCode::FeatureCalculationError, s.str());
 	}
+	if (dataVector.empty()) {
+		throw NFIQ2::Exception(
+		    NFIQ2::ErrorCode::FeatureCalculationError,
+		    "No values for histogram " + featurePrefix);
+	}
 
+	// Sorted values are walked through the bins once. The sums of
+	// cv::meanStdDev() are rounded in ascending order too, as the scores
+	// were trained with.
 	std::sort(dataVector.begin(), dataVector.end());
 
-	int *bins = new int[binCount];
-	for (int i = 0; i < binCount; i++) {
-		bins[i] = 0;
-	}
-	int currentBucket = 0;
-	double currentBound = binBoundaries.at(currentBucket);
-
-	for (std::vector<double>::iterator it = dataVector.begin();
-	     it != dataVector.end(); ++it) {
-		while (!cvIsInf(*it) && *it >= currentBound) {
-			currentBucket++;
-			currentBound = binBoundaries.at(currentBucket);
+	std::vector<double> features(binCount + 2, 0.0);
+	int currentBin = 0;
+	for (const double value : dataVector) {
+		while (!cvIsInf(value) && currentBin < binCount - 1 &&
+		    value >= binBoundaries[currentBin]) {
+			currentBin++;
 		}
-		bins[currentBucket]++;
-	}
-
-	for (int i = 0; i < binCount; i++) {
-		NFIQ2::QualityFeatureData fd;
-
-		std::stringstream s;
-		s << featurePrefix << i;
-
-		fd.featureID = s.str();
-		fd.featureDataType = NFIQ2::e_QualityFeatureDataTypeDouble;
-		fd.featureDataDouble = bins[i];
-
-		NFIQ2::QualityFeatureResult result;
-		result.featureData = fd;
-		result.returnCode = 0;
-
-		featureDataList.push_back(result);
+		features[currentBin]++;
 	}
 
-	cv::Mat dataMat(dataVector);
 	cv::Scalar mean, stdDev;
-	cv::meanStdDev(dataMat, mean, stdDev);
-
-	NFIQ2::QualityFeatureData meanFD, stdDevFD;
-	NFIQ2::QualityFeatureResult meanFR, stdDevFR;
-	std::stringstream meanSs, stdDevSs;
+	cv::meanStdDev(cv::Mat(dataVector), mean, stdDev);
+	features[binCount] = mean.val[0];
+	features[binCount + 1] = stdDev.val[0];
 
-	meanSs << featurePrefix << "Mean";
-	stdDevSs << featurePrefix << "StdDev";
-
-	meanFD.featureID = meanSs.str();
-	meanFD.featureDataType = NFIQ2::e_QualityFeatureDataTypeDouble;
-	meanFD.featureDataDouble = mean.val[0];
-	meanFR.featureData = meanFD;
-	meanFR.returnCode = 0;
-
-	stdDevFD.featureID = stdDevSs.str();
-	stdDevFD.featureDataType = NFIQ2::e_QualityFeatureDataTypeDouble;
-	stdDevFD.featureDataDouble = stdDev.val[0];
-	stdDevFR.featureData = stdDevFD;
-	stdDevFR.returnCode = 0;
-
-	featureDataList.push_back(meanFR);
-	featureDataList.push_back(stdDevFR);
-
-	if (bins) {
-		delete[] bins;
-	}
+	return features;
 }
 
 void
@@ -663,14 +825,16 @@ void
 NFIQ2::QualityFeatures::addHistogramFeatureNames(
     std::vector<std::string> &featureNames, const char *prefix, int binCount)
 {
-	for (int i = 0; i < binCount; i++) {
-		std::stringstream s;
-		s << prefix << i;
-		featureNames.push_back(s.str());
+	const auto &tables = getHistogramFeatureIDTables();
+	const auto table = tables.find(prefix);
+	if (table != tables.cend() &&
+	    table->second.size() == static_cast<std::size_t>(binCount) + 2) {
+		featureNames.insert(featureNames.end(),
+		    table->second.cbegin(), table->second.cend());
+	} else {
+		const std::vector<std::string> featureIDs =
+		    makeHistogramFeatureIDs(prefix, binCount);
+		featureNames.insert(featureNames.end(), featureIDs.cbegin(),
+		    featureIDs.cend());
 	}
-	std::stringstream meanSs, stdDevSs;
-	meanSs << prefix << "Mean";
-	stdDevSs << prefix << "StdDev";
-	featureNames.push_back(meanSs.str());
-	featureNames.push_back(stdDevSs.str());
 }
@@ -2,7 +2,6 @@
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
 
-#include <cstring>
 #include <memory>
 #include <sstream>
 #include <tuple>
@@ -10,7 +9,7 @@
 NFIQ2::QualityFeatures::FingerJetFXFeature::FingerJetFXFeature(
     const NFIQ2::FingerprintImageData &fingerprintImage)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	computeFeatureData(fingerprintImage);
 }
 
 NFIQ2::QualityFeatures::FingerJetFXFeature::~FingerJetFXFeature() = default;
@@ -87,42 +86,12 @@ NFIQ2::QualityFeatures::FingerJetFXFeature::getMinutiaData() const
 	return (this->minutiaData_);
 }
 
-std::vector<NFIQ2::QualityFeatureResult>
+void
 NFIQ2::QualityFeatures::FingerJetFXFeature::computeFeatureData(
     const NFIQ2::FingerprintImageData &fingerprintImage)
 {
 	this->templateCouldBeExtracted_ = false;
 
-	std::vector<NFIQ2::QualityFeatureResult> featureDataList;
-
-	// make local copy of fingerprint image
-	// since FJFX somehow transforms the input image
-	NFIQ2::FingerprintImageData localFingerprintImage(
-	    fingerprintImage.m_ImageWidth, fingerprintImage.m_ImageHeight,
-	    fingerprintImage.m_FingerCode, fingerprintImage.m_ImageDPI);
-	// copy data now
-	localFingerprintImage.resize(fingerprintImage.size());
-	memcpy((void *)localFingerprintImage.data(), fingerprintImage.data(),
-	    fingerprintImage.size());
-
-	NFIQ2::QualityFeatureData fd_min_cnt;
-	fd_min_cnt.featureID = "FingerJetFX_MinutiaeCount";
-	fd_min_cnt.featureDataType = NFIQ2::e_QualityFeatureDataTypeDouble;
-	fd_min_cnt.featureDataDouble = 0;
-	NFIQ2::QualityFeatureResult res_min_cnt;
-	res_min_cnt.featureData = fd_min_cnt;
-	res_min_cnt.returnCode = 0;
-
-	NFIQ2::QualityFeatureData fd_min_cnt_comrect200x200;
-	fd_min_cnt_comrect200x200.featureID =
-	    "FingerJetFX_MinCount_COMMinRect200x200";
-	fd_min_cnt_comrect200x200.featureDataType =
-	    NFIQ2::e_QualityFeatureDataTypeDouble;
-	fd_min_cnt_comrect200x200.featureDataDouble = 0;
-	NFIQ2::QualityFeatureResult res_min_cnt_comrect200x200;
-	res_min_cnt_comrect200x200.featureData = fd_min_cnt_comrect200x200;
-	res_min_cnt_comrect200x200.returnCode = 0;
-
 	NFIQ2::Timer timer;
 	timer.start();
 
@@ -142,13 +111,13 @@ NFIQ2::QualityFeatures::FingerJetFXFeature::computeFeatureData(
 		    "NULL).");
 	}
 
-	// extract feature set
+	// extract feature set (FJFX copies the pixels it enhances, so the
+	// image can be passed without making a local copy)
 	const FRFXLL_RESULT fxRes = FRFXLLCreateFeatureSetFromRaw(hCtx,
-	    (unsigned char *)localFingerprintImage.data(),
-	    localFingerprintImage.size(), localFingerprintImage.m_ImageWidth,
-	    localFingerprintImage.m_ImageHeight,
-	    localFingerprintImage.m_ImageDPI, FRFXLL_FEX_ENABLE_ENHANCEMENT,
-	    &hFeatureSet);
+	    (const unsigned char *)fingerprintImage.data(),
+	    fingerprintImage.size(), fingerprintImage.m_ImageWidth,
+	    fingerprintImage.m_ImageHeight, fingerprintImage.m_ImageDPI,
+	    FRFXLL_FEX_ENABLE_ENHANCEMENT, &hFeatureSet);
 	if (!FRFXLL_SUCCESS(fxRes)) {
 		FRFXLLCloseHandle(&hCtx);
 		throw NFIQ2::Exception(
@@ -214,18 +183,12 @@ NFIQ2::QualityFeatures::FingerJetFXFeature::computeFeatureData(
 	this->templateCouldBeExtracted_ = true;
 
 	if (minCnt == 0) {
-		// return features
-		fd_min_cnt_comrect200x200.featureDataDouble =
-		    0; // no minutiae found
-		res_min_cnt_comrect200x200.featureData =
-		    fd_min_cnt_comrect200x200;
-		res_min_cnt_comrect200x200.returnCode = 0;
-		featureDataList.push_back(res_min_cnt_comrect200x200);
-
-		fd_min_cnt.featureDataDouble = 0; // no minutiae found
-		res_min_cnt.returnCode = 0;
-		res_min_cnt.featureData = fd_min_cnt;
-		featureDataList.push_back(res_min_cnt);
+		// return features, no minutiae found
+		this->setFeature(NFIQ2::FeatureIndex::
+				     FingerJetFX_MinCount_COMMinRect200x200,
+		    0);
+		this->setFeature(
+		    NFIQ2::FeatureIndex::FingerJetFX_MinutiaeCount, 0);
 
 		// Speed
 		NFIQ2::QualityFeatureSpeed speed;
@@ -236,7 +199,7 @@ NFIQ2::QualityFeatures::FingerJetFXFeature::computeFeatureData(
 		speed.featureSpeed = timer.stop();
 		this->setSpeed(speed);
 
-		return featureDataList;
+		return;
 	}
 
 	// compute ROI and return features
@@ -267,15 +230,11 @@ NFIQ2::QualityFeatures::FingerJetFXFeature::computeFeatureData(
 	}
 
 	// return features
-	fd_min_cnt_comrect200x200.featureDataDouble = noOfMinInRect200x200;
-	res_min_cnt_comrect200x200.featureData = fd_min_cnt_comrect200x200;
-	res_min_cnt_comrect200x200.returnCode = 0;
-	featureDataList.push_back(res_min_cnt_comrect200x200);
-
-	fd_min_cnt.featureDataDouble = minCnt;
-	res_min_cnt.returnCode = 0;
-	res_min_cnt.featureData = fd_min_cnt;
-	featureDataList.push_back(res_min_cnt);
+	this->setFeature(
+	    NFIQ2::FeatureIndex::FingerJetFX_MinCount_COMMinRect200x200,
+	    noOfMinInRect200x200);
+	this->setFeature(
+	    NFIQ2::FeatureIndex::FingerJetFX_MinutiaeCount, minCnt);
 
 	NFIQ2::QualityFeatureSpeed speed;
 	speed.featureIDGroup = FingerJetFXFeature::speedFeatureIDGroup;
@@ -283,8 +242,6 @@ NFIQ2::QualityFeatures::FingerJetFXFeature::computeFeatureData(
 	speed.featureIDs.push_back("FingerJetFX_MinCount_COMMinRect200x200");
 	speed.featureSpeed = timer.stop();
 	this->setSpeed(speed);
-
-	return featureDataList;
 }
 
 const std::string NFIQ2::QualityFeatures::FingerJetFXFeature::moduleName {
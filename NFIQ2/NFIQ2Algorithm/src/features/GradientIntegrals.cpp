@@ -0,0 +1,161 @@
+#include <features/GradientIntegrals.h>
+#include <nfiq2_exception.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+/**
+ * Twice the gradient of computeNumericalGradientX() at a pixel of a block,
+ * along the direction (dy, dx), where position is the index of the pixel and
+ * length the size of the block along that direction.
+ */
+int
+doubledBlockGradient(const cv::Mat &image, const int y, const int x,
+    const int dy, const int dx, const int position, const int length)
+{
+	if (length < 2) {
+		return 0;
+	}
+
+	const int pixel = image.at<uint8_t>(y, x);
+	if (position == 0) {
+		return 2 * (image.at<uint8_t>(y + dy, x + dx) - pixel);
+	}
+	if (position == length - 1) {
+		return 2 * (pixel - image.at<uint8_t>(y - dy, x - dx));
+	}
+	return image.at<uint8_t>(y + dy, x + dx) -
+	    image.at<uint8_t>(y - dy, x - dx);
+}
+
+/** Sum of the pixels of an integral image inside rect. */
+double
+integralSum(const cv::Mat &integral, const cv::Rect &rect)
+{
+	const int x1 = rect.x + rect.width;
+	const int y1 = rect.y + rect.height;
+	return integral.at<double>(y1, x1) - integral.at<double>(rect.y, x1) -
+	    integral.at<double>(y1, rect.x) +
+	    integral.at<double>(rect.y, rect.x);
+}
+
+}
+
+NFIQ2::QualityFeatures::GradientIntegrals::GradientIntegrals(
+    const cv::Mat &image)
+    : image(image)
+{
+	if (image.type() != CV_8UC1) {
+		throw NFIQ2::Exception(
+		    NFIQ2::ErrorCode::FeatureCalculationError,
+		    "Gradient integrals need an 8-bit single channel image");
+	}
+
+	const int rows = image.rows;
+	const int cols = image.cols;
+	this->integralXX = cv::Mat::zeros(rows + 1, cols + 1, CV_64F);
+	this->integralYY = cv::Mat::zeros(rows + 1, cols + 1, CV_64F);
+	this->integralXY = cv::Mat::zeros(rows + 1, cols + 1, CV_64F);
+
+	// the tables only hold integers, which are exact up to 2^53, far
+	// more than (2 * 255)^2 times the number of pixels
+	for (int i = 1; i < rows - 1; i++) {
+		const uint8_t *above = image.ptr<uint8_t>(i - 1);
+		const uint8_t *row = image.ptr<uint8_t>(i);
+		const uint8_t *below = image.ptr<uint8_t>(i + 1);
+
+		const double *xxAbove = this->integralXX.ptr<double>(i);
+		const double *yyAbove = this->integralYY.ptr<double>(i);
+		const double *xyAbove = this->integralXY.ptr<double>(i);
+		double *xx = this->integralXX.ptr<double>(i + 1);
+		double *yy = this->integralYY.ptr<double>(i + 1);
+		double *xy = this->integralXY.ptr<double>(i + 1);
+
+		int64_t rowXX = 0, rowYY = 0, rowXY = 0;
+		for (int j = 0; j < cols; j++) {
+			if (j > 0 && j < cols - 1) {
+				const int gx = row[j + 1] - row[j - 1];
+				const int gy = below[j] - above[j];
+				rowXX += gx * gx;
+				rowYY += gy * gy;
+				rowXY += gx * gy;
+			}
+			xx[j + 1] = xxAbove[j + 1] + static_cast<double>(rowXX);
+			yy[j + 1] = yyAbove[j + 1] + static_cast<double>(rowYY);
+			xy[j + 1] = xyAbove[j + 1] + static_cast<double>(rowXY);
+		}
+	}
+	// no gradients on the last row
+	if (rows > 1) {
+		this->integralXX.row(rows - 1).copyTo(
+		    this->integralXX.row(rows));
+		this->integralYY.row(rows - 1).copyTo(
+		    this->integralYY.row(rows));
+		this->integralXY.row(rows - 1).copyTo(
+		    this->integralXY.row(rows));
+	}
+}
+
+NFIQ2::QualityFeatures::GradientIntegrals::~GradientIntegrals() = default;
+
+NFIQ2::QualityFeatures::GradientIntegrals::Sums
+NFIQ2::QualityFeatures::GradientIntegrals::getBlockSums(
+    const cv::Rect &block) const
+{
+	if (block.width <= 0 || block.height <= 0 || block.x < 0 ||
+	    block.y < 0 || block.x + block.width > this->image.cols ||
+	    block.y + block.height > this->image.rows) {
+		throw NFIQ2::Exception {
+			NFIQ2::ErrorCode::FeatureCalculationError,
+			"Block (" + std::to_string(block.x) + ", " +
+			    std::to_string(block.y) + ", " +
+			    std::to_string(block.width) + ", " +
+			    std::to_string(block.height) +
+			    ") is not inside the image"
+		};
+	}
+
+	// inner pixels have the centered differences of the image
+	double xx = 0.0, yy = 0.0, xy = 0.0;
+	if (block.width > 2 && block.height > 2) {
+		const cv::Rect inner(block.x + 1, block.y + 1, block.width - 2,
+		    block.height - 2);
+		xx = integralSum(this->integralXX, inner);
+		yy = integralSum(this->integralYY, inner);
+		xy = integralSum(this->integralXY, inner);
+	}
+
+	// one-sided differences apply to the border of the block
+	int64_t borderXX = 0, borderYY = 0, borderXY = 0;
+	for (int r = 0; r < block.height; r++) {
+		const bool borderRow = (r == 0 || r == block.height - 1);
+		const int step = borderRow ? 1 : std::max(block.width - 1, 1);
+		for (int c = 0; c < block.width; c += step) {
+			const int y = block.y + r;
+			const int x = block.x + c;
+			const int gx = doubledBlockGradient(
+			    this->image, y, x, 0, 1, c, block.width);
+			const int gy = doubledBlockGradient(
+			    this->image, y, x, 1, 0, r, block.height);
+			borderXX += gx * gx;
+			borderYY += gy * gy;
+			borderXY += gx * gy;
+		}
+	}
+
+	// the doubled gradients are integers, scaling by 1/4 is exact
+	Sums sums {};
+	sums.xx = (xx + static_cast<double>(borderXX)) * 0.25;
+	sums.yy = (yy + static_cast<double>(borderYY)) * 0.25;
+	sums.xy = (xy + static_cast<double>(borderXY)) * 0.25;
+	return sums;
+}
+
+const cv::Mat &
+NFIQ2::QualityFeatures::GradientIntegrals::getImage() const
+{
+	return this->image;
+}
@@ -0,0 +1,176 @@
+#include <features/FeatureFunctions.h>
+#include <features/ImageAnalysisContext.h>
+#include <features/ParallelFor.h>
+#include <nfiq2_exception.hpp>
+
+#include <cmath>
+#include <mutex>
+#include <sstream>
+
+const int NFIQ2::QualityFeatures::ImageAnalysisContext::segmentationBlockSize {
+	32
+};
+const double
+    NFIQ2::QualityFeatures::ImageAnalysisContext::segmentationThreshold { .1 };
+const int NFIQ2::QualityFeatures::ImageAnalysisContext::slantedBlockSizeX {
+	32
+};
+const int NFIQ2::QualityFeatures::ImageAnalysisContext::slantedBlockSizeY {
+	16
+};
+
+NFIQ2::QualityFeatures::ImageAnalysisContext::ImageAnalysisContext(
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const unsigned int threadCount)
+    : fingerprintImage(fingerprintImage)
+    , threadCount(threadCount)
+{
+	try {
+		this->image = cv::Mat(fingerprintImage.m_ImageHeight,
+		    fingerprintImage.m_ImageWidth, CV_8UC1,
+		    (void *)fingerprintImage.data());
+	} catch (const cv::Exception &e) {
+		std::stringstream ssErr;
+		ssErr << "Cannot get matrix from fingerprint image: "
+		      << e.what();
+		throw NFIQ2::Exception(
+		    NFIQ2::ErrorCode::FeatureCalculationError, ssErr.str());
+	}
+}
+
+NFIQ2::QualityFeatures::ImageAnalysisContext::~ImageAnalysisContext() =
+    default;
+
+const NFIQ2::FingerprintImageData &
+NFIQ2::QualityFeatures::ImageAnalysisContext::getFingerprintImage() const
+{
+	return this->fingerprintImage;
+}
+
+const cv::Mat &
+NFIQ2::QualityFeatures::ImageAnalysisContext::getImage() const
+{
+	return this->image;
+}
+
+unsigned int
+NFIQ2::QualityFeatures::ImageAnalysisContext::getThreadCount() const
+{
+	return this->threadCount;
+}
+
+const cv::Mat &
+NFIQ2::QualityFeatures::ImageAnalysisContext::getSegmentationMask() const
+{
+	std::call_once(this->segmentationMaskFlag, [this]() {
+		ridgesegment(this->image, segmentationBlockSize,
+		    segmentationThreshold, cv::noArray(),
+		    this->segmentationMask, cv::noArray());
+	});
+
+	return this->segmentationMask;
+}
+
+const NFIQ2::QualityFeatures::ImageAnalysisContext::BlockOrientationField &
+NFIQ2::QualityFeatures::ImageAnalysisContext::getBlockOrientationField() const
+{
+	std::call_once(this->blockOrientationFieldFlag,
+	    [this]() { this->computeBlockOrientationField(); });
+
+	return this->blockOrientationField;
+}
+
+const NFIQ2::QualityFeatures::GradientIntegrals &
+NFIQ2::QualityFeatures::ImageAnalysisContext::getGradientIntegrals() const
+{
+	std::call_once(this->gradientIntegralsFlag, [this]() {
+		this->gradientIntegrals.reset(
+		    new GradientIntegrals(this->image));
+	});
+
+	return *this->gradientIntegrals;
+}
+
+const NFIQ2::QualityFeatures::IntensityIntegrals &
+NFIQ2::QualityFeatures::ImageAnalysisContext::getIntensityIntegrals() const
+{
+	std::call_once(this->intensityIntegralsFlag, [this]() {
+		this->intensityIntegrals.reset(
+		    new IntensityIntegrals(this->image));
+	});
+
+	return *this->intensityIntegrals;
+}
+
+void
+NFIQ2::QualityFeatures::ImageAnalysisContext::computeBlockOrientationField()
+    const
+{
+	const cv::Mat &img = this->image;
+	const cv::Mat &maskim = this->getSegmentationMask();
+
+	const int blksize = segmentationBlockSize;
+	const int rows = img.rows;
+	const int cols = img.cols;
+	const double blk = static_cast<double>(blksize);
+
+	const double sumSQ = static_cast<double>(
+	    (slantedBlockSizeX * slantedBlockSizeX) +
+	    (slantedBlockSizeY * slantedBlockSizeY));
+	const double eblksz = ceil(
+	    sqrt(sumSQ)); // block size for extraction of slanted block
+	const double diff = (eblksz - blk);
+	const int blkoffset = static_cast<int>(
+	    ceil(diff / 2)); // overlapping border
+
+	const int mapRows = static_cast<int>(
+	    (static_cast<double>(rows) - diff) / blk);
+	const int mapCols = static_cast<int>(
+	    (static_cast<double>(cols) - diff) / blk);
+
+	BlockOrientationField field {};
+	field.blockSize = blksize;
+	field.blockOffset = blkoffset;
+	field.covA = cv::Mat::zeros(mapRows, mapCols, CV_64F);
+	field.covB = cv::Mat::zeros(mapRows, mapCols, CV_64F);
+	field.covC = cv::Mat::zeros(mapRows, mapCols, CV_64F);
+	field.orientation = cv::Mat::zeros(mapRows, mapCols, CV_64F);
+	field.mask = cv::Mat::zeros(mapRows, mapCols, CV_8UC1);
+
+	// Each block row only writes its own row of the field
+	parallelFor(
+	    static_cast<unsigned int>(mapRows),
+	    [&](unsigned int br) {
+		    const int r = blkoffset + static_cast<int>(br) * blksize;
+		    cv::Mat im_roi, maskB1;
+		    double cova, covb, covc;
+		    int bc = 0;
+		    for (int c = blkoffset;
+			 c < cols - (blksize + blkoffset - 1); c += blksize) {
+			    im_roi = img(
+				cv::Range(r, cv::min(r + blksize, img.rows)),
+				cv::Range(c, cv::min(c + blksize, img.cols)));
+			    maskB1 = maskim(
+				cv::Range(
+				    r, cv::min(r + blksize, maskim.rows)),
+				cv::Range(
+				    c, cv::min(c + blksize, maskim.cols)));
+			    field.mask.at<uint8_t>(br, bc) = allfun(maskB1);
+
+			    covcoef(im_roi, cova, covb, covc,
+				CENTERED_DIFFERENCES);
+			    field.covA.at<double>(br, bc) = cova;
+			    field.covB.at<double>(br, bc) = covb;
+			    field.covC.at<double>(br, bc) = covc;
+
+			    // ridge ORIENT local
+			    field.orientation.at<double>(br, bc) =
+				ridgeorient(cova, covb, covc);
+
+			    bc = bc + 1;
+		    }
+	    },
+	    this->threadCount);
+
+	this->blockOrientationField = field;
+}
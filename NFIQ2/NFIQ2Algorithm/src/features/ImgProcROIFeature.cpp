@@ -1,14 +1,23 @@
 #include <features/ImgProcROIFeature.h>
+#include <features/ParallelFor.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
 #include <opencv2/imgproc.hpp>
 
+#include <algorithm>
 #include <sstream>
 
 NFIQ2::QualityFeatures::ImgProcROIFeature::ImgProcROIFeature(
     const NFIQ2::FingerprintImageData &fingerprintImage)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	computeFeatureData(fingerprintImage, 1);
+}
+
+NFIQ2::QualityFeatures::ImgProcROIFeature::ImgProcROIFeature(
+    const ImageAnalysisContext &context)
+{
+	computeFeatureData(
+	    context.getFingerprintImage(), context.getThreadCount());
 }
 
 NFIQ2::QualityFeatures::ImgProcROIFeature::~ImgProcROIFeature() = default;
@@ -28,12 +37,11 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::getImgProcResults()
 	return (this->imgProcResults_);
 }
 
-std::vector<NFIQ2::QualityFeatureResult>
+void
 NFIQ2::QualityFeatures::ImgProcROIFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const unsigned int threadCount)
 {
-	std::vector<NFIQ2::QualityFeatureResult> featureDataList;
-
 	// check if input image has 500 dpi
 	if (fingerprintImage.m_ImageDPI != NFIQ2::e_ImageResolution_500dpi) {
 		throw NFIQ2::Exception(
@@ -63,19 +71,10 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeFeatureData(
 	// ---------------------------------------------
 	try {
 		this->imgProcResults_ = computeROI(
-		    img, 16); // block size = 16x16 pixels
-
-		NFIQ2::QualityFeatureData fd_roi_pixel_area_mean;
-		fd_roi_pixel_area_mean.featureID = "ImgProcROIArea_Mean";
-		fd_roi_pixel_area_mean.featureDataType =
-		    NFIQ2::e_QualityFeatureDataTypeDouble;
-		fd_roi_pixel_area_mean.featureDataDouble =
-		    this->imgProcResults_.meanOfROIPixels;
-		NFIQ2::QualityFeatureResult res_roi_pixel_area_mean;
-		res_roi_pixel_area_mean.featureData = fd_roi_pixel_area_mean;
-		res_roi_pixel_area_mean.returnCode = 0;
+		    img, 16, threadCount); // block size = 16x16 pixels
 
-		featureDataList.push_back(res_roi_pixel_area_mean);
+		this->setFeature(NFIQ2::FeatureIndex::ImgProcROIArea_Mean,
+		    this->imgProcResults_.meanOfROIPixels);
 
 		// Speed
 		NFIQ2::QualityFeatureSpeed speed;
@@ -99,8 +98,6 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeFeatureData(
 	}
 
 	this->imgProcComputed_ = true;
-
-	return featureDataList;
 }
 
 const std::string NFIQ2::QualityFeatures::ImgProcROIFeature::moduleName {
@@ -121,9 +118,106 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::getAllFeatureIDs()
 	return featureIDs;
 }
 
+void
+NFIQ2::QualityFeatures::ImgProcROIFeature::gaussianBlurRows(
+    const cv::Mat &src, cv::Mat &dst, const int ksize, const bool binaryInput,
+    const unsigned int threadCount)
+{
+	const int radius = ksize / 2;
+	const int rows = src.rows;
+	const unsigned int bandCount = resolveThreadCount(threadCount);
+
+	if ((bandCount == 1) && !binaryInput) {
+		cv::GaussianBlur(src, dst, cv::Size(ksize, ksize), 0.0);
+		return;
+	}
+
+	dst.create(src.size(), src.type());
+
+	int firstRow = 0;
+	int endRow = rows;
+	if (binaryInput) {
+		// 0 = black row, 255 = white row, 1 = mixed row
+		std::vector<int> rowColor(rows);
+		for (int i = 0; i < rows; i++) {
+			const int white = cv::countNonZero(src.row(i));
+			if (white == 0) {
+				rowColor[i] = 0;
+			} else if (white == src.cols) {
+				rowColor[i] = 255;
+			} else {
+				rowColor[i] = 1;
+			}
+		}
+
+		// index 0 for black, 1 for white
+		uint8_t uniformValue[2] {};
+		for (const int color : { 0, 255 }) {
+			const cv::Mat uniform(
+			    ksize, ksize, CV_8UC1, cv::Scalar(color));
+			cv::Mat uniformBlur;
+			cv::GaussianBlur(uniform, uniformBlur,
+			    cv::Size(ksize, ksize), 0.0);
+			uniformValue[color / 255] =
+			    uniformBlur.at<uint8_t>(0, 0);
+		}
+
+		firstRow = rows;
+		endRow = 0;
+		for (int i = 0; i < rows; i++) {
+			const int color = rowColor[i];
+			bool uniform = (color != 1);
+			for (int j = std::max(0, i - radius);
+			     uniform && (j < std::min(rows, i + radius + 1));
+			     j++) {
+				uniform = (rowColor[j] == color);
+			}
+
+			if (uniform) {
+				dst.row(i).setTo(
+				    cv::Scalar(uniformValue[color / 255]));
+			} else {
+				firstRow = std::min(firstRow, i);
+				endRow = i + 1;
+			}
+		}
+	}
+
+	const int blurRows = endRow - firstRow;
+	if (blurRows <= 0) {
+		return;
+	}
+
+	parallelFor(
+	    bandCount,
+	    [&](unsigned int band) {
+		    const int begin = firstRow +
+			static_cast<int>(blurRows * band / bandCount);
+		    const int end = firstRow +
+			static_cast<int>(blurRows * (band + 1) / bandCount);
+		    if (begin >= end) {
+			    return;
+		    }
+
+		    // Blur a copy, as OpenCV treats submatrices differently
+		    // (reading the pixels around them and possibly taking
+		    // another code path)
+		    const int copyBegin = std::max(0, begin - radius);
+		    const int copyEnd = std::min(rows, end + radius);
+		    const cv::Mat bandSrc =
+			src.rowRange(copyBegin, copyEnd).clone();
+		    cv::Mat bandDst;
+		    cv::GaussianBlur(
+			bandSrc, bandDst, cv::Size(ksize, ksize), 0.0);
+		    bandDst.rowRange(begin - copyBegin, end - copyBegin)
+			.copyTo(dst.rowRange(begin, end));
+	    },
+	    bandCount);
+}
+
 NFIQ2::QualityFeatures::ImgProcROIFeature::ImgProcROIResults
 NFIQ2::QualityFeatures::ImgProcROIFeature::computeROI(
-    cv::Mat &img, unsigned int bs)
+    cv::Mat &img, unsigned int bs, const unsigned int threadCount)
 {
 	ImgProcROIResults roiResults;
 
@@ -134,15 +228,15 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeROI(
 
 	// 2. Gaussian blur to get important area
 	cv::Mat blurImg;
-	cv::GaussianBlur(erodedImg, blurImg, cv::Size(41, 41), 0.0);
+	gaussianBlurRows(erodedImg, blurImg, 41, false, threadCount);
 
 	// 3. Binarize image with Otsu method
 	cv::Mat threshImg;
 	cv::threshold(blurImg, threshImg, 0, 255, cv::THRESH_OTSU);
 
-	// 4. Blur image again
+	// 4. Blur image again (threshImg only contains 0 and 255)
 	cv::Mat blurImg2;
-	cv::GaussianBlur(threshImg, blurImg2, cv::Size(91, 91), 0.0);
+	gaussianBlurRows(threshImg, blurImg2, 91, true, threadCount);
 
 	// 5. Binarize image again with Otsu method
 	cv::Mat threshImg2;
@@ -172,41 +266,48 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeROI(
 	}
 
 	// 7. remove smaller blobs at the edges that are not part of the
-	// fingerprint
-	cv::Mat ffImg = threshImg2.clone();
-	cv::Point point;
-	std::vector<cv::Rect> vecRects;
-	std::vector<cv::Point> vecPoints;
-	while (isBlackPixelAvailable(ffImg, point)) {
-		// execute flood fill algorithm starting with discovered seed
-		// and save flooded area on copied image
-		cv::Rect rect;
-		cv::floodFill(
-		    ffImg, point, cv::Scalar(255, 255, 255, 0), &rect);
-		vecRects.push_back(rect);
-		vecPoints.push_back(point);
+	// fingerprint: label the 4-connected black regions, i.e., the regions
+	// flood filling from a black pixel covers
+	cv::Mat blackImg = (threshImg2 == 0);
+	cv::Mat labels, stats, centroids;
+	const int labelCount = cv::connectedComponentsWithStats(
+	    blackImg, labels, stats, centroids, 4, CV_32S);
+
+	// order regions by their first pixel in scan order (label 0 is the
+	// white background)
+	std::vector<int> scanOrder;
+	std::vector<uint8_t> labelSeen(labelCount, 0);
+	for (int i = 0; i < labels.rows; i++) {
+		const int *labelRow = labels.ptr<int>(i);
+		for (int j = 0; j < labels.cols; j++) {
+			const int label = labelRow[j];
+			if ((label != 0) && (labelSeen[label] == 0)) {
+				labelSeen[label] = 1;
+				scanOrder.push_back(label);
+			}
+		}
 	}
 
-	// find largest region based on returned area
-	unsigned int maxIdx = 0;
+	// find largest region based on its bounding box
+	int maxLabel = 0;
 	int maxSize = 0;
-	for (unsigned int i = 0; i < vecRects.size(); i++) {
-		if ((vecRects.at(i).width * vecRects.at(i).height) > maxSize) {
-			maxIdx = i;
-			maxSize = (vecRects.at(i).width *
-			    vecRects.at(i).height);
+	for (const int label : scanOrder) {
+		const int size = stats.at<int>(label, cv::CC_STAT_WIDTH) *
+		    stats.at<int>(label, cv::CC_STAT_HEIGHT);
+		if (size > maxSize) {
+			maxLabel = label;
+			maxSize = size;
 		}
 	}
 
-	// now apply floodfill algorithm on all areas that are not the biggest
-	// one
-	for (unsigned int i = 0; i < vecRects.size(); i++) {
-		if (i != maxIdx) {
-			// apply floodfill on original image
-			// start seed first detected point
-			cv::floodFill(threshImg2,
-			    cv::Point(vecPoints.at(i).x, vecPoints.at(i).y),
-			    cv::Scalar(255, 255, 255, 0));
+	// now whiten all regions that are not the biggest one
+	for (int i = 0; i < labels.rows; i++) {
+		const int *labelRow = labels.ptr<int>(i);
+		uchar *threshRow = threshImg2.ptr<uchar>(i);
+		for (int j = 0; j < labels.cols; j++) {
+			if ((labelRow[j] != 0) && (labelRow[j] != maxLabel)) {
+				threshRow[j] = 255;
+			}
 		}
 	}
 
@@ -256,6 +357,9 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeROI(
 	unsigned int height = img.rows;
 	cv::Mat bsImg(height, width, CV_8UC1, cv::Scalar(255, 0, 0, 0));
 
+	roiResults.roiBlockMap = cv::Mat::zeros(
+	    (height + bs - 1) / bs, (width + bs - 1) / bs, CV_8UC1);
+
 	unsigned int noOfAllBlocks = 0;
 	unsigned int noOfCompleteBlocks = 0;
 	for (unsigned int i = 0; i < height; i += bs) {
@@ -284,6 +388,8 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeROI(
 				    cv::Scalar(0, 0, 0, 0), cv::FILLED);
 				roiResults.vecROIBlocks.push_back(
 				    cv::Rect(j, i, takenBS_X, takenBS_Y));
+				roiResults.roiBlockMap.at<uint8_t>(
+				    i / bs, j / bs) = 1;
 			}
 		}
 	}
@@ -298,24 +404,3 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeROI(
 
 	return roiResults;
 }
-
-bool
-NFIQ2::QualityFeatures::ImgProcROIFeature::isBlackPixelAvailable(
-    cv::Mat &img, cv::Point &point)
-{
-	bool found = false;
-	for (int i = 0; i < img.rows; i++) {
-		for (int j = 0; j < img.cols; j++) {
-			if (((int)img.at<uchar>(i, j)) == 0) {
-				point.x = j;
-				point.y = i;
-				found = true;
-				break;
-			}
-		}
-		if (found) {
-			break;
-		}
-	}
-	return found;
-}
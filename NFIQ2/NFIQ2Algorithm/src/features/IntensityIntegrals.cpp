@@ -0,0 +1,82 @@
+#include <features/IntensityIntegrals.h>
+#include <nfiq2_exception.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+NFIQ2::QualityFeatures::IntensityIntegrals::IntensityIntegrals(
+    const cv::Mat &image)
+{
+	if (image.type() != CV_8UC1) {
+		throw NFIQ2::Exception(
+		    NFIQ2::ErrorCode::FeatureCalculationError,
+		    "Intensity integrals need an 8-bit single channel image");
+	}
+
+	// sums of squared 8-bit pixels are exact in double up to 2^53 / 255^2
+	// pixels
+	cv::integral(
+	    image, this->integral, this->squaredIntegral, CV_64F, CV_64F);
+}
+
+NFIQ2::QualityFeatures::IntensityIntegrals::~IntensityIntegrals() = default;
+
+void
+NFIQ2::QualityFeatures::IntensityIntegrals::checkBlock(
+    const cv::Rect &block) const
+{
+	if (block.width <= 0 || block.height <= 0 || block.x < 0 ||
+	    block.y < 0 || block.x + block.width >= this->integral.cols ||
+	    block.y + block.height >= this->integral.rows) {
+		throw NFIQ2::Exception {
+			NFIQ2::ErrorCode::FeatureCalculationError,
+			"Block (" + std::to_string(block.x) + ", " +
+			    std::to_string(block.y) + ", " +
+			    std::to_string(block.width) + ", " +
+			    std::to_string(block.height) +
+			    ") is not inside the image"
+		};
+	}
+}
+
+double
+NFIQ2::QualityFeatures::IntensityIntegrals::blockSum(
+    const cv::Mat &integral, const cv::Rect &block)
+{
+	const int x1 = block.x + block.width;
+	const int y1 = block.y + block.height;
+	return integral.at<double>(y1, x1) - integral.at<double>(block.y, x1) -
+	    integral.at<double>(y1, block.x) +
+	    integral.at<double>(block.y, block.x);
+}
+
+double
+NFIQ2::QualityFeatures::IntensityIntegrals::getBlockMean(
+    const cv::Rect &block) const
+{
+	this->checkBlock(block);
+
+	// cv::mean() scales its sum by the reciprocal of the pixel count
+	return blockSum(this->integral, block) * (1. / block.area());
+}
+
+void
+NFIQ2::QualityFeatures::IntensityIntegrals::getBlockMeanStdDev(
+    const cv::Rect &block, double &mean, double &stddev) const
+{
+	this->checkBlock(block);
+
+	const double scale = 1. / block.area();
+	mean = blockSum(this->integral, block) * scale;
+	stddev = std::sqrt(std::max(
+	    blockSum(this->squaredIntegral, block) * scale - mean * mean, 0.));
+}
+
+cv::Rect
+NFIQ2::QualityFeatures::IntensityIntegrals::getImageRect() const
+{
+	return cv::Rect(
+	    0, 0, this->integral.cols - 1, this->integral.rows - 1);
+}
@@ -1,5 +1,7 @@
+#include <features/BlockWorkspace.h>
 #include <features/FeatureFunctions.h>
 #include <features/LCSFeature.h>
+#include <features/ParallelFor.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
 #include <opencv2/core.hpp>
@@ -12,7 +14,14 @@ double loclar(cv::Mat &block, const double orientation, const int v1sz_x,
 NFIQ2::QualityFeatures::LCSFeature::LCSFeature(
     const NFIQ2::FingerprintImageData &fingerprintImage)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	const ImageAnalysisContext context(fingerprintImage);
+	computeFeatureData(context);
+}
+
+NFIQ2::QualityFeatures::LCSFeature::LCSFeature(
+    const ImageAnalysisContext &context)
+{
+	computeFeatureData(context);
 }
 
 NFIQ2::QualityFeatures::LCSFeature::~LCSFeature() = default;
@@ -39,32 +48,20 @@ NFIQ2::QualityFeatures::LCSFeature::getAllFeatureIDs()
 const std::string NFIQ2::QualityFeatures::LCSFeature::speedFeatureIDGroup =
     "Local clarity";
 
-std::vector<NFIQ2::QualityFeatureResult>
+void
 NFIQ2::QualityFeatures::LCSFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const ImageAnalysisContext &context)
 {
-	std::vector<NFIQ2::QualityFeatureResult> featureDataList;
-
 	// check if input image has 500 dpi
-	if (fingerprintImage.m_ImageDPI != NFIQ2::e_ImageResolution_500dpi) {
+	if (context.getFingerprintImage().m_ImageDPI !=
+	    NFIQ2::e_ImageResolution_500dpi) {
 		throw NFIQ2::Exception(
 		    NFIQ2::ErrorCode::FeatureCalculationError,
 		    "Only 500 dpi fingerprint images are supported!");
 	}
 
-	cv::Mat img;
-	try {
-		// get matrix from fingerprint image
-		img = cv::Mat(fingerprintImage.m_ImageHeight,
-		    fingerprintImage.m_ImageWidth, CV_8UC1,
-		    (void *)fingerprintImage.data());
-	} catch (const cv::Exception &e) {
-		std::stringstream ssErr;
-		ssErr << "Cannot get matrix from fingerprint image: "
-		      << e.what();
-		throw NFIQ2::Exception(
-		    NFIQ2::ErrorCode::FeatureCalculationError, ssErr.str());
-	}
+	// get matrix from fingerprint image
+	const cv::Mat &img = context.getImage();
 
 	NFIQ2::Timer timerLCS;
 	double timeLCS = 0.0;
@@ -77,9 +74,8 @@ NFIQ2::QualityFeatures::LCSFeature::computeFeatureData(
 		const int v1sz_x = blocksize;
 		const int v1sz_y = blocksize / 2;
 
-		cv::Mat maskim;
-		ridgesegment(img, blocksize, threshold, cv::noArray(), maskim,
-		    cv::noArray());
+		const ImageAnalysisContext::BlockOrientationField &field =
+		    context.getBlockOrientationField();
 
 		// ----------
 		// compute LCS
@@ -95,71 +91,51 @@ NFIQ2::QualityFeatures::LCSFeature::computeFeatureData(
 		int blkoffset = static_cast<int>(
 		    ceil(diff / 2)); // overlapping border
 
+		assert((field.blockSize == blocksize) &&
+		    (field.blockOffset == blkoffset));
+
 		int mapRows = static_cast<int>(
 		    (static_cast<double>(rows) - diff) / blk);
 		int mapCols = static_cast<int>(
 		    (static_cast<double>(cols) - diff) / blk);
 
-		cv::Mat maskBseg = cv::Mat::zeros(mapRows, mapCols, CV_8UC1);
-		cv::Mat blkorient = cv::Mat::zeros(mapRows, mapCols, CV_64F);
+		const cv::Mat &maskBseg = field.mask;
+		const cv::Mat &blkorient = field.orientation;
 
-		std::vector<double> dataVector;
-		dataVector.reserve(mapRows * mapCols);
-
-		cv::Mat im_roi, blkwim;
-		cv::Mat maskB1;
 		cv::Mat lcs = cv::Mat::zeros(mapRows, mapCols, CV_64F);
-		double cova, covb, covc;
-		// Image processed NOT from beg to end but with a border around
-		// - can't be vectorized:(
-		int br = 0;
-		int bc = 0;
-
-		for (int r = blkoffset; r < rows - (blocksize + blkoffset - 1);
-		     r += blocksize) {
-			for (int c = blkoffset;
-			     c < cols - (blocksize + blkoffset - 1);
-			     c += blocksize) {
-				im_roi = img(
-				    cv::Range(
-					r, cv::min(r + blocksize, img.rows)),
-				    cv::Range(
-					c, cv::min(c + blocksize, img.cols)));
-				//      blkim = im(r:r+blksz-1, c:c+blksz-1);
-				maskB1 = maskim(
-				    cv::Range(
-					r, cv::min(r + blocksize, maskim.rows)),
-				    cv::Range(c,
-					cv::min(c + blocksize, maskim.cols)));
-				//      maskB1 = maskim(r:r+blksz-1,
-				//      c:c+blksz-1);
-				maskBseg.at<uint8_t>(br, bc) = allfun(maskB1);
-				covcoef(im_roi, cova, covb, covc,
-				    CENTERED_DIFFERENCES);
-
-				// ridge ORIENT local
-				blkorient.at<double>(br, bc) = ridgeorient(
-				    cova, covb, covc);
-				// overlapping windows (border = blkoffset)
-				blkwim = img(
-				    cv::Range(r - blkoffset,
-					cv::min(r + blocksize + blkoffset,
-					    img.rows)),
-				    cv::Range(c - blkoffset,
-					cv::min(c + blocksize + blkoffset,
-					    img.cols)));
-				lcs.at<double>(br, bc) = loclar(blkwim,
-				    blkorient.at<double>(br, bc), v1sz_x,
-				    v1sz_y, scannerRes, padFlag);
-				if (maskBseg.at<uint8_t>(br, bc) == 1) {
-					dataVector.push_back(
-					    lcs.at<double>(br, bc));
-				}
-				bc = bc + 1;
-			}
-			br = br + 1;
-			bc = 0;
-		}
+
+		// Image processed NOT from beg to end but with a border around.
+		// Block rows are independent and are concatenated in scan
+		// order.
+		std::vector<double> dataVector = parallelForConcat<double>(
+		    static_cast<unsigned int>(mapRows),
+		    [&](unsigned int br, std::vector<double> &rowValues) {
+			    const int r = blkoffset +
+				static_cast<int>(br) * blocksize;
+			    cv::Mat blkwim;
+			    int bc = 0;
+			    for (int c = blkoffset;
+				 c < cols - (blocksize + blkoffset - 1);
+				 c += blocksize) {
+				    // overlapping windows (border = blkoffset)
+				    blkwim = img(
+					cv::Range(r - blkoffset,
+					    cv::min(r + blocksize + blkoffset,
+						img.rows)),
+					cv::Range(c - blkoffset,
+					    cv::min(c + blocksize + blkoffset,
+						img.cols)));
+				    lcs.at<double>(br, bc) = loclar(blkwim,
+					blkorient.at<double>(br, bc), v1sz_x,
+					v1sz_y, scannerRes, padFlag);
+				    if (maskBseg.at<uint8_t>(br, bc) == 1) {
+					    rowValues.push_back(
+						lcs.at<double>(br, bc));
+				    }
+				    bc = bc + 1;
+			    }
+		    },
+		    context.getThreadCount());
 
 		timeLCS = timerLCS.stop();
 
@@ -173,8 +149,9 @@ NFIQ2::QualityFeatures::LCSFeature::computeFeatureData(
 		histogramBins10.push_back(LCSHISTLIMITS[6]);
 		histogramBins10.push_back(LCSHISTLIMITS[7]);
 		histogramBins10.push_back(LCSHISTLIMITS[8]);
-		addHistogramFeatures(featureDataList, "LCS_Bin10_",
-		    histogramBins10, dataVector, 10);
+		this->setFeatures(NFIQ2::FeatureIndex::LCS_Bin10_0,
+		    computeHistogramFeatures(
+			"LCS_Bin10_", histogramBins10, dataVector, 10));
 
 		// Speed
 		NFIQ2::QualityFeatureSpeed speed;
@@ -197,7 +174,6 @@ NFIQ2::QualityFeatures::LCSFeature::computeFeatureData(
 		    NFIQ2::ErrorCode::FeatureCalculationError,
 		    "Unknown exception occurred!");
 	}
-	return featureDataList;
 }
 ///////////////////////////////////////////////////////////////////////
 /***
@@ -242,10 +218,6 @@ loclar(cv::Mat &block, const double orientation, const int v1sz_x,
 		};
 	}
 
-	cv::Mat blockRotated;
-	NFIQ2::QualityFeatures::getRotatedBlock(
-	    block, orientation, padFlag, blockRotated);
-
 	//% set x and y
 	int xoff = v1sz_x / 2;
 	int yoff = v1sz_y / 2;
@@ -262,8 +234,16 @@ loclar(cv::Mat &block, const double orientation, const int v1sz_x,
 	int rowend = icBlock + yoff;
 	int colstart = icBlock - (xoff - 1) - 1;
 	int colend = icBlock + xoff;
-	cv::Mat v2 = blockRotated(
-	    cv::Range(rowstart, rowend), cv::Range(colstart, colend));
+	// rotate image to get the ridges vertical, computing only the
+	// cropped window
+	using NFIQ2::QualityFeatures::BlockWorkspace;
+	cv::Mat &v2 = BlockWorkspace::forCurrentThread().get(
+	    BlockWorkspace::Buffer::RotatedBlock, rowend - rowstart,
+	    colend - colstart, block.type());
+	NFIQ2::QualityFeatures::getRotatedBlockWindow(block, orientation,
+	    padFlag,
+	    cv::Rect(colstart, rowstart, colend - colstart, rowend - rowstart),
+	    v2);
 
 	std::vector<uint8_t> ridval;
 	std::vector<double> dt;
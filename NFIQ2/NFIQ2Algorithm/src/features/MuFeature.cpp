@@ -8,7 +8,14 @@
 NFIQ2::QualityFeatures::MuFeature::MuFeature(
     const NFIQ2::FingerprintImageData &fingerprintImage)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	const ImageAnalysisContext context(fingerprintImage);
+	computeFeatureData(context);
+}
+
+NFIQ2::QualityFeatures::MuFeature::MuFeature(
+    const ImageAnalysisContext &context)
+{
+	computeFeatureData(context);
 }
 
 NFIQ2::QualityFeatures::MuFeature::~MuFeature() = default;
@@ -16,11 +23,12 @@ NFIQ2::QualityFeatures::MuFeature::~MuFeature() = default;
 const std::string NFIQ2::QualityFeatures::MuFeature::speedFeatureIDGroup =
     "Contrast";
 
-std::vector<NFIQ2::QualityFeatureResult>
+void
 NFIQ2::QualityFeatures::MuFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const ImageAnalysisContext &context)
 {
-	std::vector<NFIQ2::QualityFeatureResult> featureDataList;
+	const NFIQ2::FingerprintImageData &fingerprintImage =
+	    context.getFingerprintImage();
 
 	// check if input image has 500 dpi
 	if (fingerprintImage.m_ImageDPI != NFIQ2::e_ImageResolution_500dpi) {
@@ -29,23 +37,21 @@ NFIQ2::QualityFeatures::MuFeature::computeFeatureData(
 		    "Only 500 dpi fingerprint images are supported!");
 	}
 
-	cv::Mat img;
+	NFIQ2::Timer timer;
+	timer.start();
+
+	// block means, mean and stddev all come from the same integral images
+	const IntensityIntegrals *integrals = nullptr;
 	try {
-		// get matrix from fingerprint image
-		img = cv::Mat(fingerprintImage.m_ImageHeight,
-		    fingerprintImage.m_ImageWidth, CV_8UC1,
-		    (void *)fingerprintImage.data());
+		integrals = &context.getIntensityIntegrals();
 	} catch (const cv::Exception &e) {
 		std::stringstream ssErr;
-		ssErr << "Cannot get matrix from fingerprint image: "
+		ssErr << "Cannot compute integral images of fingerprint image: "
 		      << e.what();
 		throw NFIQ2::Exception(
 		    NFIQ2::ErrorCode::FeatureCalculationError, ssErr.str());
 	}
 
-	NFIQ2::Timer timer;
-	timer.start();
-
 	// -------------------------
 	// compute Mu Mu Block (MMB)
 	// -------------------------
@@ -68,12 +74,9 @@ NFIQ2::QualityFeatures::MuFeature::computeFeatureData(
 					takenBS_Y = (height - i);
 				}
 
-				// create block and calculate mean of greyscale
-				// values
-				cv::Mat block = img(
-				    cv::Rect(j, i, takenBS_X, takenBS_Y));
-				cv::Scalar m = mean(block);
-				vecMeans.push_back(m.val[0]);
+				// calculate mean of greyscale values of block
+				vecMeans.push_back(integrals->getBlockMean(
+				    cv::Rect(j, i, takenBS_X, takenBS_Y)));
 			}
 		}
 
@@ -85,15 +88,7 @@ NFIQ2::QualityFeatures::MuFeature::computeFeatureData(
 		}
 
 		// return MMB value
-		NFIQ2::QualityFeatureData fd_mmb;
-		fd_mmb.featureID = "MMB";
-		fd_mmb.featureDataType = NFIQ2::e_QualityFeatureDataTypeDouble;
-		fd_mmb.featureDataDouble = avg;
-		NFIQ2::QualityFeatureResult res_mmb;
-		res_mmb.featureData = fd_mmb;
-		res_mmb.returnCode = 0;
-
-		featureDataList.push_back(res_mmb);
+		this->setFeature(NFIQ2::FeatureIndex::MMB, avg);
 	} catch (const cv::Exception &e) {
 		std::stringstream ssErr;
 		ssErr << "Cannot compute feature Mu Mu Block (MMB): "
@@ -112,25 +107,18 @@ NFIQ2::QualityFeatures::MuFeature::computeFeatureData(
 	// compute Mu and Standard Deviation = Sigma
 	// -----------------------------------------
 
-	cv::Scalar stddev;
-	cv::Scalar mu;
+	double stddev = 0.0;
+	double mu = 0.0;
 	try {
 		// calculate stddev of input image = sigma and mu = mean
-		cv::meanStdDev(img, mu, stddev);
+		integrals->getBlockMeanStdDev(
+		    integrals->getImageRect(), mu, stddev);
 		// assign sigma value
-		this->sigma = stddev.val[0];
+		this->sigma = stddev;
 		this->sigmaComputed = true;
 
 		// return mu value
-		NFIQ2::QualityFeatureData fd_mu;
-		fd_mu.featureID = "Mu";
-		fd_mu.featureDataType = NFIQ2::e_QualityFeatureDataTypeDouble;
-		fd_mu.featureDataDouble = mu.val[0];
-		NFIQ2::QualityFeatureResult res_mu;
-		res_mu.featureData = fd_mu;
-		res_mu.returnCode = 0;
-
-		featureDataList.push_back(res_mu);
+		this->setFeature(NFIQ2::FeatureIndex::Mu, mu);
 	} catch (const cv::Exception &e) {
 		std::stringstream ssErr;
 		ssErr << "Cannot compute feature Sigma (stddev) and Mu (mean): "
@@ -152,8 +140,6 @@ NFIQ2::QualityFeatures::MuFeature::computeFeatureData(
 	speed.featureIDs.push_back("Mu");
 	speed.featureSpeed = timer.stop();
 	this->setSpeed(speed);
-
-	return featureDataList;
 }
 
 double
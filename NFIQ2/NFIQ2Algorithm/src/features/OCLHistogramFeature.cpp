@@ -8,7 +8,14 @@
 NFIQ2::QualityFeatures::OCLHistogramFeature::OCLHistogramFeature(
     const NFIQ2::FingerprintImageData &fingerprintImage)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	const ImageAnalysisContext context(fingerprintImage);
+	computeFeatureData(context);
+}
+
+NFIQ2::QualityFeatures::OCLHistogramFeature::OCLHistogramFeature(
+    const ImageAnalysisContext &context)
+{
+	computeFeatureData(context);
 }
 
 NFIQ2::QualityFeatures::OCLHistogramFeature::~OCLHistogramFeature() = default;
@@ -17,33 +24,19 @@ const std::string
     NFIQ2::QualityFeatures::OCLHistogramFeature::speedFeatureIDGroup =
 	"Orientation certainty";
 
-std::vector<NFIQ2::QualityFeatureResult>
+void
 NFIQ2::QualityFeatures::OCLHistogramFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const ImageAnalysisContext &context)
 {
-	std::vector<NFIQ2::QualityFeatureResult> featureDataList;
-
-	cv::Mat img;
-
 	// check if input image has 500 dpi
-	if (fingerprintImage.m_ImageDPI != NFIQ2::e_ImageResolution_500dpi) {
+	if (context.getFingerprintImage().m_ImageDPI !=
+	    NFIQ2::e_ImageResolution_500dpi) {
 		throw NFIQ2::Exception(
 		    NFIQ2::ErrorCode::FeatureCalculationError,
 		    "Only 500 dpi fingerprint images are supported!");
 	}
 
-	try {
-		// get matrix from fingerprint image
-		img = cv::Mat(fingerprintImage.m_ImageHeight,
-		    fingerprintImage.m_ImageWidth, CV_8UC1,
-		    (void *)fingerprintImage.data());
-	} catch (const cv::Exception &e) {
-		std::stringstream ssErr;
-		ssErr << "Cannot get matrix from fingerprint image: "
-		      << e.what();
-		throw NFIQ2::Exception(
-		    NFIQ2::ErrorCode::FeatureCalculationError, ssErr.str());
-	}
+	const cv::Mat &img = context.getImage();
 
 	// compute OCL
 	NFIQ2::Timer timerOCL;
@@ -52,6 +45,9 @@ NFIQ2::QualityFeatures::OCLHistogramFeature::computeFeatureData(
 	try {
 		timerOCL.start();
 
+		const GradientIntegrals &gradients =
+		    context.getGradientIntegrals();
+
 		// divide into blocks
 		for (int i = 0; i < img.rows; i += BS_OCL) {
 			for (int j = 0; j < img.cols; j += BS_OCL) {
@@ -69,14 +65,12 @@ NFIQ2::QualityFeatures::OCLHistogramFeature::computeFeatureData(
 					// only take blocks of full size
 					// ignore other blocks
 
-					// get current block
-					cv::Mat bl_img = img(cv::Rect(
-					    j, i, actualBS_X, actualBS_Y));
-
 					// get OCL value of current block
 					double bl_ocl = 0.0;
-					if (!getOCLValueOfBlock(
-						bl_img, bl_ocl)) {
+					if (!getOCLValueOfBlock(gradients,
+						cv::Rect(j, i, actualBS_X,
+						    actualBS_Y),
+						bl_ocl)) {
 						continue; // block is not used
 					}
 
@@ -95,8 +89,9 @@ NFIQ2::QualityFeatures::OCLHistogramFeature::computeFeatureData(
 		histogramBins10.push_back(OCLPHISTLIMITS[6]);
 		histogramBins10.push_back(OCLPHISTLIMITS[7]);
 		histogramBins10.push_back(OCLPHISTLIMITS[8]);
-		addHistogramFeatures(
-		    featureDataList, "OCL_Bin10_", histogramBins10, oclres, 10);
+		this->setFeatures(NFIQ2::FeatureIndex::OCL_Bin10_0,
+		    computeHistogramFeatures(
+			"OCL_Bin10_", histogramBins10, oclres, 10));
 
 		timeOCL = timerOCL.stop();
 
@@ -121,37 +116,35 @@ NFIQ2::QualityFeatures::OCLHistogramFeature::computeFeatureData(
 		    NFIQ2::ErrorCode::FeatureCalculationError,
 		    "Unknown exception occurred!");
 	}
-
-	return featureDataList;
 }
 
 bool
 NFIQ2::QualityFeatures::OCLHistogramFeature::getOCLValueOfBlock(
     const cv::Mat &block, double &ocl)
+{
+	const GradientIntegrals gradients(block);
+	return getOCLValueOfSums(
+	    gradients.getBlockSums(cv::Rect(0, 0, block.cols, block.rows)),
+	    ocl);
+}
+
+bool
+NFIQ2::QualityFeatures::OCLHistogramFeature::getOCLValueOfBlock(
+    const GradientIntegrals &gradients, const cv::Rect &block, double &ocl)
+{
+	return getOCLValueOfSums(gradients.getBlockSums(block), ocl);
+}
+
+bool
+NFIQ2::QualityFeatures::OCLHistogramFeature::getOCLValueOfSums(
+    const GradientIntegrals::Sums &sums, double &ocl)
 {
 	double eigv_max = 0.0, eigv_min = 0.0;
-	// compute the numerical gradients of the block
-	cv::Mat grad_x, grad_y;
-	computeNumericalGradients(block, grad_x, grad_y);
-
-	// compute covariance matrix
-	double a = 0.0;
-	double b = 0.0;
-	double c = 0.0;
-	for (unsigned int k = 0; k < BS_OCL; k++) {
-		for (unsigned int l = 0; l < BS_OCL; l++) {
-			a += (grad_x.at<double>(l, k) *
-			    grad_x.at<double>(l, k));
-			b += (grad_y.at<double>(l, k) *
-			    grad_y.at<double>(l, k));
-			c += (grad_x.at<double>(l, k) *
-			    grad_y.at<double>(l, k));
-		}
-	}
+
 	// take mean value covariance matrix values
-	a /= (BS_OCL * BS_OCL);
-	b /= (BS_OCL * BS_OCL);
-	c /= (BS_OCL * BS_OCL);
+	const double a = sums.xx / (BS_OCL * BS_OCL);
+	const double b = sums.yy / (BS_OCL * BS_OCL);
+	const double c = sums.xy / (BS_OCL * BS_OCL);
 
 	// compute the eigenvalues
 	eigv_max = ((a + b) + sqrt(pow(a - b, 2) + 4 * pow(c, 2))) / 2.0;
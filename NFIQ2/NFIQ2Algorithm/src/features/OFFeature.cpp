@@ -11,7 +11,7 @@
 NFIQ2::QualityFeatures::OFFeature::OFFeature(
     const NFIQ2::FingerprintImageData &fingerprintImage)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	computeFeatureData(fingerprintImage);
 }
 
 NFIQ2::QualityFeatures::OFFeature::~OFFeature() = default;
@@ -35,12 +35,10 @@ NFIQ2::QualityFeatures::OFFeature::getAllFeatureIDs()
 const std::string NFIQ2::QualityFeatures::OFFeature::speedFeatureIDGroup =
     "Orientation flow";
 
-std::vector<NFIQ2::QualityFeatureResult>
+void
 NFIQ2::QualityFeatures::OFFeature::computeFeatureData(
     const NFIQ2::FingerprintImageData &fingerprintImage)
 {
-	std::vector<NFIQ2::QualityFeatureResult> featureDataList;
-
 	// check if input image has 500 dpi
 	if (fingerprintImage.m_ImageDPI != NFIQ2::e_ImageResolution_500dpi) {
 		throw NFIQ2::Exception(
@@ -242,8 +240,9 @@ NFIQ2::QualityFeatures::OFFeature::computeFeatureData(
 		histogramBins10.push_back(OFHISTLIMITS[6]);
 		histogramBins10.push_back(OFHISTLIMITS[7]);
 		histogramBins10.push_back(OFHISTLIMITS[8]);
-		addHistogramFeatures(featureDataList, "OF_Bin10_",
-		    histogramBins10, dataVector, 10);
+		this->setFeatures(NFIQ2::FeatureIndex::OF_Bin10_0,
+		    computeHistogramFeatures(
+			"OF_Bin10_", histogramBins10, dataVector, 10));
 
 		timeOF = timerOF.stop();
 
@@ -268,5 +267,4 @@ NFIQ2::QualityFeatures::OFFeature::computeFeatureData(
 		    NFIQ2::ErrorCode::FeatureCalculationError,
 		    "Unknown exception occurred!");
 	}
-	return featureDataList;
 }
@@ -0,0 +1,227 @@
+#include <features/ParallelFor.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/* Set while the current thread runs a parallelFor() body */
+thread_local bool insideParallelFor { false };
+
+// The x87 control word (double-precision rounding on 32-bit Linux, see
+// QualityFeatures::Impl::setFPU()) is per thread, so workers take the mode
+// of the calling thread.
+#if defined(__linux) && defined(__i386__)
+unsigned short
+getFPUMode()
+{
+	unsigned short mode {};
+	asm("fnstcw %0" : "=m"(mode));
+	return mode;
+}
+
+void
+setFPUMode(unsigned short mode)
+{
+	asm("fldcw %0" : : "m"(mode));
+}
+#else
+unsigned short
+getFPUMode()
+{
+	return 0;
+}
+
+void
+setFPUMode(unsigned short)
+{
+}
+#endif
+
+/** State of one parallelFor() call, shared with the pool threads helping */
+struct Loop {
+	Loop(const unsigned int count,
+	    const std::function<void(unsigned int)> &body)
+	    : count(count)
+	    , body(body)
+	    , exceptions(count)
+	    , fpuMode(getFPUMode())
+	{
+	}
+
+	/** Processes indices until all have been claimed */
+	void
+	work()
+	{
+		const bool outerInsideParallelFor = insideParallelFor;
+		insideParallelFor = true;
+		unsigned int processed = 0;
+		for (unsigned int i = next++; i < count; i = next++) {
+			try {
+				body(i);
+			} catch (...) {
+				exceptions[i] = std::current_exception();
+			}
+			processed++;
+		}
+		insideParallelFor = outerInsideParallelFor;
+
+		if (processed != 0) {
+			std::lock_guard<std::mutex> lock(mutex);
+			done += processed;
+			if (done == count) {
+				finished.notify_all();
+			}
+		}
+	}
+
+	/** Blocks until all indices have been processed */
+	void
+	wait()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		finished.wait(lock, [this]() { return done == count; });
+	}
+
+	const unsigned int count;
+	/* only used for claimed indices, i.e., before wait() returns */
+	const std::function<void(unsigned int)> &body;
+	std::vector<std::exception_ptr> exceptions;
+	const unsigned short fpuMode;
+
+	std::atomic<unsigned int> next { 0 };
+	std::mutex mutex {};
+	std::condition_variable finished {};
+	unsigned int done { 0 };
+};
+
+/**
+ * Threads shared by all parallelFor() calls. They persist, so that
+ * thread_local state such as BlockWorkspace is reused across loops.
+ */
+class WorkerPool {
+    public:
+	/**
+	 * The pool is never destroyed: its threads may still run the
+	 * destructors of thread_local objects using other statics at exit.
+	 */
+	static WorkerPool &
+	get()
+	{
+		static WorkerPool *pool = new WorkerPool();
+		return *pool;
+	}
+
+	/**
+	 * Starts threads until there are threadCount, if possible.
+	 *
+	 * @return number of threads available, at most threadCount
+	 */
+	unsigned int
+	reserve(const unsigned int threadCount)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		while (threads.size() < threadCount) {
+			try {
+				threads.emplace_back([this]() { run(); });
+			} catch (const std::system_error &) {
+				// indices are picked up by the running threads
+				break;
+			}
+		}
+		return std::min(threadCount,
+		    static_cast<unsigned int>(threads.size()));
+	}
+
+	/** Runs task on the next idle thread */
+	void
+	submit(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			tasks.push_back(std::move(task));
+		}
+		available.notify_one();
+	}
+
+    private:
+	WorkerPool() = default;
+
+	void
+	run()
+	{
+		while (true) {
+			std::function<void()> task {};
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				available.wait(
+				    lock, [this]() { return !tasks.empty(); });
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+			task();
+		}
+	}
+
+	std::mutex mutex {};
+	std::condition_variable available {};
+	std::deque<std::function<void()>> tasks {};
+	std::vector<std::thread> threads {};
+};
+
+}
+
+void
+NFIQ2::QualityFeatures::parallelFor(const unsigned int count,
+    const std::function<void(unsigned int)> &body, unsigned int threadCount)
+{
+	if (count == 0) {
+		return;
+	}
+
+	threadCount = std::min(resolveThreadCount(threadCount), count);
+
+	const auto loop = std::make_shared<Loop>(count, body);
+	if (threadCount > 1) {
+		WorkerPool &pool = WorkerPool::get();
+		const unsigned int helperCount =
+		    pool.reserve(threadCount - 1);
+		for (unsigned int t = 0; t < helperCount; t++) {
+			pool.submit([loop]() {
+				setFPUMode(loop->fpuMode);
+				loop->work();
+			});
+		}
+	}
+
+	loop->work();
+	loop->wait();
+
+	for (const auto &exception : loop->exceptions) {
+		if (exception) {
+			std::rethrow_exception(exception);
+		}
+	}
+}
+
+unsigned int
+NFIQ2::QualityFeatures::resolveThreadCount(const unsigned int threadCount)
+{
+	// nested loops run on the thread of the enclosing body
+	if (insideParallelFor) {
+		return 1;
+	}
+	if (threadCount == 0) {
+		return std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	return threadCount;
+}
@@ -3,6 +3,7 @@
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 
@@ -11,7 +12,16 @@ NFIQ2::QualityFeatures::QualityMapFeatures::QualityMapFeatures(
     const ImgProcROIFeature::ImgProcROIResults &imgProcResults)
     : imgProcResults_ { imgProcResults }
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	const ImageAnalysisContext context(fingerprintImage);
+	computeFeatureData(context);
+}
+
+NFIQ2::QualityFeatures::QualityMapFeatures::QualityMapFeatures(
+    const ImageAnalysisContext &context,
+    const ImgProcROIFeature::ImgProcROIResults &imgProcResults)
+    : imgProcResults_ { imgProcResults }
+{
+	computeFeatureData(context);
 }
 
 NFIQ2::QualityFeatures::QualityMapFeatures::~QualityMapFeatures() = default;
@@ -20,14 +30,13 @@ const std::string
     NFIQ2::QualityFeatures::QualityMapFeatures::speedFeatureIDGroup =
 	"Quality map";
 
-std::vector<NFIQ2::QualityFeatureResult>
+void
 NFIQ2::QualityFeatures::QualityMapFeatures::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const ImageAnalysisContext &context)
 {
-	std::vector<NFIQ2::QualityFeatureResult> featureDataList;
-
 	// check if input image has 500 dpi
-	if (fingerprintImage.m_ImageDPI != NFIQ2::e_ImageResolution_500dpi) {
+	if (context.getFingerprintImage().m_ImageDPI !=
+	    NFIQ2::e_ImageResolution_500dpi) {
 		throw NFIQ2::Exception(
 		    NFIQ2::ErrorCode::FeatureCalculationError,
 		    "Only 500 dpi fingerprint images are supported!");
@@ -36,20 +45,6 @@ NFIQ2::QualityFeatures::QualityMapFeatures::computeFeatureData(
 	NFIQ2::Timer timer;
 	timer.start();
 
-	cv::Mat img;
-	try {
-		// get matrix from fingerprint image
-		img = cv::Mat(fingerprintImage.m_ImageHeight,
-		    fingerprintImage.m_ImageWidth, CV_8UC1,
-		    (void *)fingerprintImage.data());
-	} catch (const cv::Exception &e) {
-		std::stringstream ssErr;
-		ssErr << "Cannot get matrix from fingerprint image: "
-		      << e.what();
-		throw NFIQ2::Exception(
-		    NFIQ2::ErrorCode::FeatureCalculationError, ssErr.str());
-	}
-
 	try {
 		// ------------------------
 		// orientation map features
@@ -59,30 +54,17 @@ NFIQ2::QualityFeatures::QualityMapFeatures::computeFeatureData(
 		// uses block size 16
 		double coherenceSumFilter = 0.0;
 		double coherenceRelFilter = 0.0;
-		cv::Mat orientationMapImgFilter = computeOrientationMap(img,
-		    true, coherenceSumFilter, coherenceRelFilter, 16,
-		    this->imgProcResults_);
+		computeOrientationMap(context.getGradientIntegrals(), true,
+		    coherenceSumFilter, coherenceRelFilter, 16,
+		    this->imgProcResults_, false);
 
 		// return features based on coherence values of orientation map
-		NFIQ2::QualityFeatureData fd_om_2;
-		fd_om_2.featureID = "OrientationMap_ROIFilter_CoherenceRel";
-		fd_om_2.featureDataType = NFIQ2::e_QualityFeatureDataTypeDouble;
-		fd_om_2.featureDataDouble = coherenceRelFilter;
-		NFIQ2::QualityFeatureResult res_om_2;
-		res_om_2.featureData = fd_om_2;
-		res_om_2.returnCode = 0;
-
-		featureDataList.push_back(res_om_2);
-
-		NFIQ2::QualityFeatureData fd_om_1;
-		fd_om_1.featureID = "OrientationMap_ROIFilter_CoherenceSum";
-		fd_om_1.featureDataType = NFIQ2::e_QualityFeatureDataTypeDouble;
-		fd_om_1.featureDataDouble = coherenceSumFilter;
-		NFIQ2::QualityFeatureResult res_om_1;
-		res_om_1.featureData = fd_om_1;
-		res_om_1.returnCode = 0;
-
-		featureDataList.push_back(res_om_1);
+		this->setFeature(NFIQ2::FeatureIndex::
+				     OrientationMap_ROIFilter_CoherenceRel,
+		    coherenceRelFilter);
+		this->setFeature(NFIQ2::FeatureIndex::
+				     OrientationMap_ROIFilter_CoherenceSum,
+		    coherenceSumFilter);
 
 		NFIQ2::QualityFeatureSpeed speed;
 		speed.featureIDGroup = QualityMapFeatures::speedFeatureIDGroup;
@@ -101,23 +83,62 @@ NFIQ2::QualityFeatures::QualityMapFeatures::computeFeatureData(
 	} catch (const NFIQ2::Exception &) {
 		throw;
 	}
+}
+
+cv::Mat
+NFIQ2::QualityFeatures::QualityMapFeatures::getROIBlockMap(const cv::Mat &img,
+    unsigned int bs, const ImgProcROIFeature::ImgProcROIResults &roiResults)
+{
+	const int mapRows = (img.rows + (int)bs - 1) / (int)bs;
+	const int mapCols = (img.cols + (int)bs - 1) / (int)bs;
+	if (roiResults.chosenBlockSize == bs &&
+	    roiResults.roiBlockMap.rows == mapRows &&
+	    roiResults.roiBlockMap.cols == mapCols) {
+		return roiResults.roiBlockMap;
+	}
 
-	return featureDataList;
+	// ROI blocks were computed for another grid: mark the ones that
+	// coincide with a block of this grid
+	cv::Mat roiBlockMap = cv::Mat::zeros(mapRows, mapCols, CV_8UC1);
+	for (const cv::Rect &block : roiResults.vecROIBlocks) {
+		if (block.x < 0 || block.y < 0 || block.x >= img.cols ||
+		    block.y >= img.rows || (block.x % (int)bs) != 0 ||
+		    (block.y % (int)bs) != 0) {
+			continue;
+		}
+		if (block.width == std::min((int)bs, img.cols - block.x) &&
+		    block.height == std::min((int)bs, img.rows - block.y)) {
+			roiBlockMap.at<uint8_t>(
+			    block.y / (int)bs, block.x / (int)bs) = 1;
+		}
+	}
+
+	return roiBlockMap;
 }
 
 cv::Mat
-NFIQ2::QualityFeatures::QualityMapFeatures::computeOrientationMap(cv::Mat &img,
-    bool bFilterByROI, double &coherenceSum, double &coherenceRel,
-    unsigned int bs, ImgProcROIFeature::ImgProcROIResults roiResults)
+NFIQ2::QualityFeatures::QualityMapFeatures::computeOrientationMap(
+    const GradientIntegrals &gradients, bool bFilterByROI,
+    double &coherenceSum, double &coherenceRel, unsigned int bs,
+    const ImgProcROIFeature::ImgProcROIResults &roiResults,
+    bool bComputeOrientationImage)
 {
 	coherenceSum = 0.0;
 	coherenceRel = 0.0;
 
-	cv::Mat visImage;
+	const cv::Mat &img = gradients.getImage();
 
 	// result image (block pixel values = orientation in degrees)
-	cv::Mat omImg = cv::Mat(img.rows, img.cols, CV_8UC1,
-	    cv::Scalar(0, 0, 0, 0)); // empty black image
+	cv::Mat omImg;
+	if (bComputeOrientationImage) {
+		omImg = cv::Mat(img.rows, img.cols, CV_8UC1,
+		    cv::Scalar(0, 0, 0, 0)); // empty black image
+	}
+
+	cv::Mat roiBlockMap;
+	if (bFilterByROI) {
+		roiBlockMap = getROIBlockMap(img, bs, roiResults);
+	}
 
 	// divide into blocks
 	for (int i = 0; i < img.rows; i += bs) {
@@ -129,55 +150,26 @@ NFIQ2::QualityFeatures::QualityMapFeatures::computeOrientationMap(cv::Mat &img,
 				  (img.rows - i) :
 				  bs;
 
-			// check if block is vector of ROI blocks
-			if (bFilterByROI) {
-				// search for ROI block
-				bool bBlockFound = false;
-				for (unsigned int k = 0;
-				     k < roiResults.vecROIBlocks.size(); k++) {
-					if (roiResults.vecROIBlocks.at(k).x ==
-						j &&
-					    roiResults.vecROIBlocks.at(k).y ==
-						i &&
-					    roiResults.vecROIBlocks.at(k)
-						    .width == actualBS_X &&
-					    roiResults.vecROIBlocks.at(k)
-						    .height == actualBS_Y) {
-						// block found
-						bBlockFound = true;
-						break;
-					}
-				}
-
-				if (!bBlockFound) {
-					for (int k = i; k < (i + actualBS_Y);
-					     k++) {
-						for (int l = j;
-						     l < (j + actualBS_X);
-						     l++) {
-							omImg.at<uchar>(k,
-							    l) = 255; // set
-								      // value
-								      // of
-								      // block
-								      // to
-								      // white
-						}
-					}
-					continue; // do not compute angle for a
-						  // non-ROI block (as no ridge
-						  // lines will be there)
+			// check if block is one of the ROI blocks
+			if (bFilterByROI &&
+			    roiBlockMap.at<uint8_t>(i / bs, j / bs) == 0) {
+				if (bComputeOrientationImage) {
+					// set value of block to white
+					omImg(cv::Rect(
+						  j, i, actualBS_X, actualBS_Y))
+					    .setTo(255);
 				}
+				continue; // do not compute angle for a
+					  // non-ROI block (as no ridge
+					  // lines will be there)
 			}
 
-			// get current block
-			cv::Mat bl_img = img(
-			    cv::Rect(j, i, actualBS_X, actualBS_Y));
-
 			// get orientation angle of current block
 			double angle = 0.0;
 			double coherence = 0.0;
-			if (!getAngleOfBlock(bl_img, angle, coherence)) {
+			if (!getAngleOfBlock(gradients,
+				cv::Rect(j, i, actualBS_X, actualBS_Y), angle,
+				coherence)) {
 				continue; // block does not have angle = no
 					  // ridge line
 			}
@@ -186,6 +178,10 @@ NFIQ2::QualityFeatures::QualityMapFeatures::computeOrientationMap(cv::Mat &img,
 			}
 			coherenceSum += coherence;
 
+			if (!bComputeOrientationImage) {
+				continue;
+			}
+
 			// draw angle to final orientation map
 			// angle in degrees = greyvalue of block
 			// is in range [0..180] degrees
@@ -223,40 +219,32 @@ bool
 NFIQ2::QualityFeatures::QualityMapFeatures::getAngleOfBlock(
     const cv::Mat &block, double &angle, double &coherence)
 {
-	// compute the numerical gradients of the block
-	// in x and y direction
-	cv::Mat grad_x, grad_y;
-	computeNumericalGradients(block, grad_x, grad_y);
+	const GradientIntegrals gradients(block);
+	return getAngleOfSums(
+	    gradients.getBlockSums(cv::Rect(0, 0, block.cols, block.rows)),
+	    angle, coherence);
+}
 
-	// compute gsx and gsy which are average squared gradients
-	double sum_y = 0.0;
-	double sum_x = 0.0;
-	double coh_sum2 = 0.0;
-	for (int k = 0; k < block.rows; k++) {
-		for (int l = 0; l < block.cols; l++) {
-			// 2 * gx * gy
-			double gy = (2 * grad_x.at<double>(k, l) *
-			    grad_y.at<double>(k, l));
-			if (std::isnan(gy)) {
-				sum_y += 0;
-			} else {
-				sum_y += gy;
-			}
-			// gx^2 - gy^2
-			double gx = ((grad_x.at<double>(k, l) *
-					 grad_x.at<double>(k, l)) -
-			    (grad_y.at<double>(k, l) *
-				grad_y.at<double>(k, l)));
-			if (std::isnan(gx)) {
-				sum_x += 0;
-			} else {
-				sum_x += gx;
-			}
+bool
+NFIQ2::QualityFeatures::QualityMapFeatures::getAngleOfBlock(
+    const GradientIntegrals &gradients, const cv::Rect &block, double &angle,
+    double &coherence)
+{
+	return getAngleOfSums(gradients.getBlockSums(block), angle, coherence);
+}
 
-			// values for coherence
-			coh_sum2 += sqrt(gy * gy + gx * gx);
-		}
-	}
+bool
+NFIQ2::QualityFeatures::QualityMapFeatures::getAngleOfSums(
+    const GradientIntegrals::Sums &sums, double &angle, double &coherence)
+{
+	// compute gsx and gsy which are average squared gradients
+	// sum of 2 * gx * gy
+	const double sum_y = 2 * sums.xy;
+	// sum of gx^2 - gy^2
+	const double sum_x = sums.xx - sums.yy;
+	// values for coherence: sqrt((2 * gx * gy)^2 + (gx^2 - gy^2)^2) of
+	// each pixel is gx^2 + gy^2
+	double coh_sum2 = sums.xx + sums.yy;
 
 	// get radiant and convert to correct orientation angle
 	// angle is in range [0..pi]
@@ -280,39 +268,6 @@ NFIQ2::QualityFeatures::QualityMapFeatures::getAngleOfBlock(
 	return true;
 }
 
-cv::Mat
-NFIQ2::QualityFeatures::QualityMapFeatures::computeNumericalGradientX(
-    const cv::Mat &mat)
-{
-	cv::Mat out(mat.rows, mat.cols, CV_64F, cv::Scalar(0));
-
-	for (int y = 0; y < mat.rows; ++y) {
-		const uchar *in_r = mat.ptr<uchar>(y);
-		double *out_r = out.ptr<double>(y);
-
-		if (mat.cols > 1) {
-			out_r[0] = in_r[1] - in_r[0];
-			for (int x = 1; x < mat.cols - 1; ++x) {
-				out_r[x] = (in_r[x + 1] - in_r[x - 1]) / 2.0;
-			}
-			out_r[mat.cols - 1] = in_r[mat.cols - 1] -
-			    in_r[mat.cols - 2];
-		}
-	}
-	return out;
-}
-
-void
-NFIQ2::QualityFeatures::QualityMapFeatures::computeNumericalGradients(
-    const cv::Mat &mat, cv::Mat &grad_x, cv::Mat &grad_y)
-{
-	// get x-gradient
-	grad_x = computeNumericalGradientX(mat);
-	// to get the y-gradient: take the x-gradient of the transpose matrix
-	// and transpose it again
-	grad_y = computeNumericalGradientX(mat.t()).t();
-}
-
 const std::string NFIQ2::QualityFeatures::QualityMapFeatures::moduleName {
 	"NFIQ2_QualityMap"
 };
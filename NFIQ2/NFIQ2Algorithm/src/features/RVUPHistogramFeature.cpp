@@ -1,4 +1,6 @@
+#include <features/BlockWorkspace.h>
 #include <features/FeatureFunctions.h>
+#include <features/ParallelFor.h>
 #include <features/RVUPHistogramFeature.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
@@ -14,7 +16,14 @@ void rvuhist(cv::Mat block, const double orientation, const int v1sz_x,
 NFIQ2::QualityFeatures::RVUPHistogramFeature::RVUPHistogramFeature(
     const NFIQ2::FingerprintImageData &fingerprintImage)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	const ImageAnalysisContext context(fingerprintImage);
+	computeFeatureData(context);
+}
+
+NFIQ2::QualityFeatures::RVUPHistogramFeature::RVUPHistogramFeature(
+    const ImageAnalysisContext &context)
+{
+	computeFeatureData(context);
 }
 
 NFIQ2::QualityFeatures::RVUPHistogramFeature::~RVUPHistogramFeature() = default;
@@ -23,32 +32,20 @@ const std::string
     NFIQ2::QualityFeatures::RVUPHistogramFeature::speedFeatureIDGroup =
 	"Ridge valley uniformity";
 
-std::vector<NFIQ2::QualityFeatureResult>
+void
 NFIQ2::QualityFeatures::RVUPHistogramFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const ImageAnalysisContext &context)
 {
-	std::vector<NFIQ2::QualityFeatureResult> featureDataList;
-
 	// check if input image has 500 dpi
-	if (fingerprintImage.m_ImageDPI != NFIQ2::e_ImageResolution_500dpi) {
+	if (context.getFingerprintImage().m_ImageDPI !=
+	    NFIQ2::e_ImageResolution_500dpi) {
 		throw NFIQ2::Exception(
 		    NFIQ2::ErrorCode::FeatureCalculationError,
 		    "Only 500 dpi fingerprint images are supported!");
 	}
 
-	cv::Mat img;
-	try {
-		// get matrix from fingerprint image
-		img = cv::Mat(fingerprintImage.m_ImageHeight,
-		    fingerprintImage.m_ImageWidth, CV_8UC1,
-		    (void *)fingerprintImage.data());
-	} catch (const cv::Exception &e) {
-		std::stringstream ssErr;
-		ssErr << "Cannot get matrix from fingerprint image: "
-		      << e.what();
-		throw NFIQ2::Exception(
-		    NFIQ2::ErrorCode::FeatureCalculationError, ssErr.str());
-	}
+	// get matrix from fingerprint image
+	const cv::Mat &img = context.getImage();
 
 	// ----------
 	// compute RVU
@@ -59,17 +56,13 @@ NFIQ2::QualityFeatures::RVUPHistogramFeature::computeFeatureData(
 	try {
 		timerRVU.start();
 
-		cv::Mat maskim;
 		const int blksize = this->blocksize;
 		const int v1sz_x = this->slantedBlockSizeX;
 		const int v1sz_y = this->slantedBlockSizeY;
 
-		assert((blksize > 0) && (this->threshold > 0));
-
-		ridgesegment(img, blksize, this->threshold, cv::noArray(),
-		    maskim, cv::noArray());
+		const ImageAnalysisContext::BlockOrientationField &field =
+		    context.getBlockOrientationField();
 
-		int rows = img.rows;
 		int cols = img.cols;
 		double blk = static_cast<double>(blksize);
 
@@ -81,65 +74,44 @@ NFIQ2::QualityFeatures::RVUPHistogramFeature::computeFeatureData(
 		int blkoffset = static_cast<int>(
 		    ceil(diff / 2)); // overlapping border
 
-		int mapRows = static_cast<int>(
-		    (static_cast<double>(rows) - diff) / blk);
-		int mapCols = static_cast<int>(
-		    (static_cast<double>(cols) - diff) / blk);
-
-		cv::Mat maskBseg = cv::Mat::zeros(mapRows, mapCols, CV_8UC1);
-		cv::Mat blkorient = cv::Mat::zeros(mapRows, mapCols, CV_64F);
-
-		cv::Mat im_roi, blkwim;
-		cv::Mat maskB1;
-		double cova, covb, covc;
-		// Image processed NOT from beg to end but with a border around
-		// - can't be vectorized:(
-		int br = 0;
-		int bc = 0;
-
-		std::vector<double> rvures;
-		std::vector<uint8_t> NanVec;
-		for (int r = blkoffset; r < rows - (blksize + blkoffset - 1);
-		     r += blksize) {
-			for (int c = blkoffset;
-			     c < cols - (blksize + blkoffset - 1);
-			     c += blksize) {
-				im_roi = img(
-				    cv::Range(
-					r, cv::min(r + blksize, img.rows)),
-				    cv::Range(
-					c, cv::min(c + blksize, img.cols)));
-				maskB1 = maskim(
-				    cv::Range(
-					r, cv::min(r + blksize, maskim.rows)),
-				    cv::Range(
-					c, cv::min(c + blksize, maskim.cols)));
-				maskBseg.at<uint8_t>(br, bc) = allfun(maskB1);
-				covcoef(im_roi, cova, covb, covc,
-				    CENTERED_DIFFERENCES);
-
-				// ridge ORIENT local
-				blkorient.at<double>(br, bc) = ridgeorient(
-				    cova, covb, covc);
-				// overlapping windows (border = blkoffset)
-				blkwim = img(
-				    cv::Range(r - blkoffset,
-					cv::min(
-					    r + blksize + blkoffset, img.rows)),
-				    cv::Range(c - blkoffset,
-					cv::min(c + blksize + blkoffset,
-					    img.cols)));
-				if (maskBseg.at<uint8_t>(br, bc) == 1) {
-					rvuhist(blkwim,
-					    blkorient.at<double>(br, bc),
-					    v1sz_x, v1sz_y, this->padFlag,
-					    rvures, NanVec);
-				}
-				bc = bc + 1;
-			}
-			br = br + 1;
-			bc = 0;
-		}
+		assert((field.blockSize == blksize) &&
+		    (field.blockOffset == blkoffset));
+
+		const cv::Mat &maskBseg = field.mask;
+		const cv::Mat &blkorient = field.orientation;
+
+		// Image processed NOT from beg to end but with a border around.
+		// Block rows are independent and are concatenated in scan
+		// order.
+		std::vector<double> rvures = parallelForConcat<double>(
+		    static_cast<unsigned int>(maskBseg.rows),
+		    [&](unsigned int br, std::vector<double> &rowValues) {
+			    const int r = blkoffset +
+				static_cast<int>(br) * blksize;
+			    cv::Mat blkwim;
+			    std::vector<uint8_t> NanVec;
+			    int bc = 0;
+			    for (int c = blkoffset;
+				 c < cols - (blksize + blkoffset - 1);
+				 c += blksize) {
+				    // overlapping windows (border = blkoffset)
+				    blkwim = img(
+					cv::Range(r - blkoffset,
+					    cv::min(r + blksize + blkoffset,
+						img.rows)),
+					cv::Range(c - blkoffset,
+					    cv::min(c + blksize + blkoffset,
+						img.cols)));
+				    if (maskBseg.at<uint8_t>(br, bc) == 1) {
+					    rvuhist(blkwim,
+						blkorient.at<double>(br, bc),
+						v1sz_x, v1sz_y, this->padFlag,
+						rowValues, NanVec);
+				    }
+				    bc = bc + 1;
+			    }
+		    },
+		    context.getThreadCount());
 
 		// RIDGE-VALLEY UNIFORMITY
 		std::vector<double> histogramBins10;
@@ -152,8 +124,9 @@ NFIQ2::QualityFeatures::RVUPHistogramFeature::computeFeatureData(
 		histogramBins10.push_back(RVUPHISTLIMITS[6]);
 		histogramBins10.push_back(RVUPHISTLIMITS[7]);
 		histogramBins10.push_back(RVUPHISTLIMITS[8]);
-		addHistogramFeatures(featureDataList, "RVUP_Bin10_",
-		    histogramBins10, rvures, 10);
+		this->setFeatures(NFIQ2::FeatureIndex::RVUP_Bin10_0,
+		    computeHistogramFeatures(
+			"RVUP_Bin10_", histogramBins10, rvures, 10));
 
 		timeRVU = timerRVU.stop();
 
@@ -178,7 +151,6 @@ NFIQ2::QualityFeatures::RVUPHistogramFeature::computeFeatureData(
 		    NFIQ2::ErrorCode::FeatureCalculationError,
 		    "Unknown exception occurred!");
 	}
-	return featureDataList;
 }
 
 const std::string NFIQ2::QualityFeatures::RVUPHistogramFeature::moduleName {
@@ -245,10 +217,6 @@ rvuhist(cv::Mat block, const double orientation, const int v1sz_x,
 		};
 	}
 
-	cv::Mat blockRotated;
-	NFIQ2::QualityFeatures::getRotatedBlock(
-	    block, orientation, padFlag, blockRotated);
-
 	//% set x and y
 	int xoff = v1sz_x / 2;
 	int yoff = v1sz_y / 2;
@@ -261,9 +229,20 @@ rvuhist(cv::Mat block, const double orientation, const int v1sz_x,
 	// Note: Matlab uses matrix indices starting at 1, OpenCV starts at 0.
 	// Also, OpenCV ranges are open-ended on the upper end.
 
-	cv::Mat blockCropped = blockRotated(
-	    cv::Range((icBlock - (yoff - 1) - 1), (icBlock + yoff)),
-	    cv::Range((icBlock - (xoff - 1) - 1), (icBlock + xoff))); // v2
+	// rotate image to get the ridges vertical, computing only the
+	// cropped window
+	const int rowstart = icBlock - (yoff - 1) - 1;
+	const int rowend = icBlock + yoff;
+	const int colstart = icBlock - (xoff - 1) - 1;
+	const int colend = icBlock + xoff;
+	using NFIQ2::QualityFeatures::BlockWorkspace;
+	cv::Mat &blockCropped = BlockWorkspace::forCurrentThread().get(
+	    BlockWorkspace::Buffer::RotatedBlock, rowend - rowstart,
+	    colend - colstart, block.type()); // v2
+	NFIQ2::QualityFeatures::getRotatedBlockWindow(block, orientation,
+	    padFlag,
+	    cv::Rect(colstart, rowstart, colend - colstart, rowend - rowstart),
+	    blockCropped);
 
 	std::vector<uint8_t> ridval;
 	std::vector<double> dt;
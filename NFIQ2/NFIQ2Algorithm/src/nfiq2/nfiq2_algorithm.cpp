@@ -39,6 +39,23 @@ NFIQ2::Algorithm::computeQualityScore(
 	return (this->pimpl->computeQualityScore(rawImage));
 }
 
+unsigned int
+NFIQ2::Algorithm::computeQualityScore(
+    const NFIQ2::FingerprintImageView &rawImage) const
+{
+	return (this->pimpl->computeQualityScore(rawImage));
+}
+
+unsigned int
+NFIQ2::Algorithm::computeQualityScoreCascaded(
+    const NFIQ2::FingerprintImageData &rawImage,
+    std::unordered_map<std::string, NFIQ2::ActionableQualityFeedback>
+	&actionableQualityFeedback) const
+{
+	return (this->pimpl->computeQualityScoreCascaded(
+	    rawImage, actionableQualityFeedback));
+}
+
 unsigned int
 NFIQ2::Algorithm::computeQualityScore(
     const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
@@ -55,6 +72,21 @@ NFIQ2::Algorithm::computeQualityScore(
 	return (this->pimpl->computeQualityScore(features));
 }
 
+unsigned int
+NFIQ2::Algorithm::computeQualityScore(
+    const NFIQ2::FeatureVector &featureVector) const
+{
+	return (this->pimpl->computeQualityScore(featureVector));
+}
+
+std::vector<unsigned int>
+NFIQ2::Algorithm::computeQualityScores(const double *featureMatrix,
+    const std::size_t sampleCount, const unsigned int threadCount) const
+{
+	return (this->pimpl->computeQualityScores(
+	    featureMatrix, sampleCount, threadCount));
+}
+
 std::string
 NFIQ2::Algorithm::getParameterHash() const
 {
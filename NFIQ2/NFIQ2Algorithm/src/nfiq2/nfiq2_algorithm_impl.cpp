@@ -1,6 +1,7 @@
 #include <features/FDAFeature.h>
 #include <features/FJFXMinutiaeQualityFeatures.h>
 #include <features/FingerJetFXFeature.h>
+#include <features/ImageAnalysisContext.h>
 #include <features/ImgProcROIFeature.h>
 #include <features/LCSFeature.h>
 #include <features/MuFeature.h>
@@ -14,6 +15,7 @@
 #include <nfiq2_timer.hpp>
 
 #include "nfiq2_algorithm_impl.hpp"
+#include "nfiq2_qualityfeatures_impl.hpp"
 #include <iomanip>
 #include <string>
 #include <vector>
@@ -21,8 +23,8 @@
 NFIQ2::Algorithm::Impl::Impl()
     : initialized { false }
 {
-#ifdef EMBED_RANDOMFOREST_PARAMETERS
-	// init RF module that takes some time to load the parameters
+#ifdef NFIQ2_EMBED_RANDOM_FOREST_PARAMETERS
+	// init RF module from the node arrays compiled into the library
 	this->m_parameterHash = m_RandomForestML.initModule();
 	this->initialized = true;
 #endif
@@ -69,22 +71,35 @@ NFIQ2::Algorithm::Impl::getQualityPrediction(
 	return quality;
 }
 
-unsigned int
-NFIQ2::Algorithm::Impl::computeQualityScore(
+double
+NFIQ2::Algorithm::Impl::getQualityPrediction(
     const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
 	&features) const
 {
 	this->throwIfUninitialized();
 
-	const std::unordered_map<std::string, NFIQ2::QualityFeatureData>
-	    quality = NFIQ2::QualityFeatures::getQualityFeatureData(features);
+	return getQualityPrediction(
+	    NFIQ2::QualityFeatures::getFeatureVector(features));
+}
 
-	if (quality.size() == 0) {
-		// no features have been computed
-		throw NFIQ2::Exception(
-		    NFIQ2::ErrorCode::FeatureCalculationError,
-		    "No features have been computed");
-	}
+double
+NFIQ2::Algorithm::Impl::getQualityPrediction(
+    const NFIQ2::FeatureVector &featureVector) const
+{
+	this->throwIfUninitialized();
+
+	double quality {};
+	m_RandomForestML.evaluate(featureVector, quality);
+
+	return quality;
+}
+
+unsigned int
+NFIQ2::Algorithm::Impl::computeQualityScore(
+    const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
+	&features) const
+{
+	this->throwIfUninitialized();
 
 	// ---------------------
 	// compute quality score
@@ -92,7 +107,7 @@ NFIQ2::Algorithm::Impl::computeQualityScore(
 
 	double qualityScore {};
 	try {
-		qualityScore = getQualityPrediction(quality);
+		qualityScore = getQualityPrediction(features);
 	} catch (const NFIQ2::Exception &) {
 		throw;
 	}
@@ -106,9 +121,9 @@ NFIQ2::Algorithm::Impl::computeQualityScore(
 {
 	this->throwIfUninitialized();
 
-	// --------------------------------------------------------
-	// compute quality features (including actionable feedback)
-	// --------------------------------------------------------
+	// ------------------------
+	// compute quality features
+	// ------------------------
 
 	std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
 	    features {};
@@ -126,28 +141,122 @@ NFIQ2::Algorithm::Impl::computeQualityScore(
 		    NFIQ2::ErrorCode::UnknownError, e.what());
 	}
 
-	const std::unordered_map<std::string, NFIQ2::QualityFeatureData>
-	    quality = NFIQ2::QualityFeatures::getQualityFeatureData(features);
+	return this->computeQualityScore(features);
+}
+
+unsigned int
+NFIQ2::Algorithm::Impl::computeQualityScore(
+    const NFIQ2::FingerprintImageView &rawImage) const
+{
+	this->throwIfUninitialized();
+
+	// ------------------------
+	// compute quality features
+	// ------------------------
+
+	std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
+	    features {};
+	try {
+		/* use double-precision rounding for 32-bit linux */
+		NFIQ2::QualityFeatures::Impl::setFPU(0x27F);
 
-	if (quality.size() == 0) {
-		// no features have been computed
+		// only the pixels inside the white frame are copied
+		const NFIQ2::FingerprintImageData croppedImage =
+		    rawImage.removeWhiteFrameAroundFingerprint();
+
+		// intermediate results shared between the quality modules
+		const NFIQ2::QualityFeatures::ImageAnalysisContext context(
+		    croppedImage);
+
+		features =
+		    NFIQ2::QualityFeatures::Impl::computeCroppedQualityFeatures(
+			context,
+			std::make_shared<NFIQ2::QualityFeatures::MuFeature>(
+			    context));
+	} catch (const NFIQ2::Exception &) {
+		throw;
+	} catch (const std::exception &e) {
+		/*
+		 * Nothing should get here, but computeQualityFeatures() calls
+		 * a lot of code...
+		 */
 		throw NFIQ2::Exception(
-		    NFIQ2::ErrorCode::FeatureCalculationError,
-		    "No features have been computed");
+		    NFIQ2::ErrorCode::UnknownError, e.what());
 	}
 
-	// ---------------------
-	// compute quality score
-	// ---------------------
+	return this->computeQualityScore(features);
+}
 
-	double qualityScore {};
+unsigned int
+NFIQ2::Algorithm::Impl::computeQualityScoreCascaded(
+    const NFIQ2::FingerprintImageData &rawImage,
+    std::unordered_map<std::string, NFIQ2::ActionableQualityFeedback>
+	&actionableQualityFeedback) const
+{
+	this->throwIfUninitialized();
+
+	std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
+	    features {};
 	try {
-		qualityScore = getQualityPrediction(quality);
+		/* use double-precision rounding for 32-bit linux */
+		NFIQ2::QualityFeatures::Impl::setFPU(0x27F);
+
+		const NFIQ2::FingerprintImageData croppedImage =
+		    rawImage.removeWhiteFrameAroundFingerprint();
+
+		// intermediate results shared between the quality modules,
+		// computed as far as the modules run
+		const NFIQ2::QualityFeatures::ImageAnalysisContext context(
+		    croppedImage);
+
+		// ----------------------------------------------------
+		// reject empty and uniform images using Mu module only
+		// ----------------------------------------------------
+
+		const std::shared_ptr<NFIQ2::QualityFeatures::MuFeature>
+		    muFeatureModule = std::make_shared<
+			NFIQ2::QualityFeatures::MuFeature>(context);
+
+		actionableQualityFeedback =
+		    NFIQ2::QualityFeatures::getActionableQualityFeedback(
+			std::vector<std::shared_ptr<
+			    NFIQ2::QualityFeatures::BaseFeature>> {
+			    muFeatureModule });
+
+		const bool isUniformImage =
+		    actionableQualityFeedback
+			.at(ActionableQualityFeedbackIdentifier::UniformImage)
+			.actionableQualityValue <
+		    ActionableQualityFeedbackThreshold::UniformImage;
+		const bool isEmptyImage =
+		    actionableQualityFeedback
+			.at(ActionableQualityFeedbackIdentifier::
+				EmptyImageOrContrastTooLow)
+			.actionableQualityValue >
+		    ActionableQualityFeedbackThreshold::
+			EmptyImageOrContrastTooLow;
+		if (isUniformImage || isEmptyImage) {
+			return 0;
+		}
+
+		features =
+		    NFIQ2::QualityFeatures::Impl::computeCroppedQualityFeatures(
+			context, muFeatureModule);
 	} catch (const NFIQ2::Exception &) {
 		throw;
+	} catch (const std::exception &e) {
+		/*
+		 * Nothing should get here, but computeQualityFeatures() calls
+		 * a lot of code...
+		 */
+		throw NFIQ2::Exception(
+		    NFIQ2::ErrorCode::UnknownError, e.what());
 	}
 
-	return (unsigned int)qualityScore;
+	actionableQualityFeedback =
+	    NFIQ2::QualityFeatures::getActionableQualityFeedback(features);
+
+	return this->computeQualityScore(features);
 }
 
 unsigned int
@@ -160,6 +269,34 @@ NFIQ2::Algorithm::Impl::computeQualityScore(
 	return (unsigned int)getQualityPrediction(features);
 }
 
+unsigned int
+NFIQ2::Algorithm::Impl::computeQualityScore(
+    const NFIQ2::FeatureVector &featureVector) const
+{
+	this->throwIfUninitialized();
+
+	return (unsigned int)getQualityPrediction(featureVector);
+}
+
+std::vector<unsigned int>
+NFIQ2::Algorithm::Impl::computeQualityScores(const double *featureMatrix,
+    const std::size_t sampleCount, const unsigned int threadCount) const
+{
+	this->throwIfUninitialized();
+
+	std::vector<double> qualityValues {};
+	m_RandomForestML.evaluate(
+	    featureMatrix, sampleCount, qualityValues, threadCount);
+
+	std::vector<unsigned int> qualityScores {};
+	qualityScores.reserve(qualityValues.size());
+	for (const auto &qualityValue : qualityValues) {
+		qualityScores.push_back((unsigned int)qualityValue);
+	}
+
+	return qualityScores;
+}
+
 std::string
 NFIQ2::Algorithm::Impl::getParameterHash() const
 {
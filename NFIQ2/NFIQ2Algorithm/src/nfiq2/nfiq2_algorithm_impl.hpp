@@ -3,7 +3,9 @@
 
 #include <nfiq2_algorithm.hpp>
 #include <nfiq2_exception.hpp>
+#include <nfiq2_featurevector.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
+#include <nfiq2_fingerprintimageview.hpp>
 #include <nfiq2_interfacedefinitions.hpp>
 #include <prediction/RandomForestML.h>
 
@@ -60,6 +62,45 @@ class Algorithm::Impl {
 	unsigned int computeQualityScore(
 	    const NFIQ2::FingerprintImageData &rawImage) const;
 
+	/**
+	 * @brief
+	 * Computes the quality score from a view of fingerprint image data.
+	 *
+	 * @param rawImage
+	 * View of the fingerprint image in raw format.
+	 *
+	 * @return
+	 * Computed quality score.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded.
+	 */
+	unsigned int computeQualityScore(
+	    const NFIQ2::FingerprintImageView &rawImage) const;
+
+	/**
+	 * @brief
+	 * Computes the quality score from the provided fingerprint image data,
+	 * rejecting empty and uniform images before the expensive quality
+	 * modules are computed.
+	 *
+	 * @param rawImage
+	 * Fingerprint image in raw format.
+	 * @param actionableQualityFeedback
+	 * Set to the actionable quality feedback of the image.
+	 *
+	 * @return
+	 * Computed quality score, 0 if the image was rejected.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded.
+	 */
+	unsigned int computeQualityScoreCascaded(
+	    const NFIQ2::FingerprintImageData &rawImage,
+	    std::unordered_map<std::string,
+		NFIQ2::ActionableQualityFeedback> &actionableQualityFeedback)
+	    const;
+
 	/**
 	 * @brief
 	 * Computes the quality score from a vector of extracted `features`
@@ -97,6 +138,53 @@ class Algorithm::Impl {
 	    const std::unordered_map<std::string, NFIQ2::QualityFeatureData>
 		&features) const;
 
+	/**
+	 * @brief
+	 * Computes the quality score from the dense values of the features
+	 * consumed by the random forest.
+	 *
+	 * @param featureVector
+	 * Feature values, as returned by
+	 * NFIQ2::QualityFeatures::getFeatureVector().
+	 *
+	 * @return
+	 * Computed quality score.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded.
+	 */
+	unsigned int computeQualityScore(
+	    const NFIQ2::FeatureVector &featureVector) const;
+
+	/**
+	 * @brief
+	 * Computes the quality scores of many samples of feature values at
+	 * once, e.g., to score stored features again with another model.
+	 *
+	 * @details
+	 * Each tree of the random forest is evaluated for a chunk of samples
+	 * before moving to the next tree. Scores are identical to those of
+	 * computeQualityScore().
+	 *
+	 * @param featureMatrix
+	 * sampleCount contiguous rows of NFIQ2::FeatureVector::Size feature
+	 * values each, ordered as NFIQ2::FeatureIndex.
+	 * @param sampleCount
+	 * Number of rows of featureMatrix.
+	 * @param threadCount
+	 * Number of threads chunks of rows are distributed over, 0 for the
+	 * number of hardware threads.
+	 *
+	 * @return
+	 * Computed quality score of each row.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded.
+	 */
+	std::vector<unsigned int> computeQualityScores(
+	    const double *featureMatrix, std::size_t sampleCount,
+	    unsigned int threadCount = 1) const;
+
 	/**
 	 * @brief
 	 * Obtain MD5 checksum of Random Forest parameter file loaded.
@@ -160,6 +248,46 @@ class Algorithm::Impl {
 	    const std::unordered_map<std::string, NFIQ2::QualityFeatureData>
 		&features) const;
 
+	/**
+	 * @brief
+	 * Retrieves NFIQ 2 quality score directly from computed quality
+	 * modules.
+	 *
+	 * @details
+	 * Only the feature values consumed by the random forest are gathered,
+	 * into a FeatureVector, without building a map keyed by feature ID.
+	 *
+	 * @param features
+	 * Quality modules as returned by computeQualityFeatures().
+	 *
+	 * @return
+	 * Computed NFIQ 2 quality score.
+	 *
+	 * @throws Exception
+	 * No features have been computed, failure to compute, or called before
+	 * random forest parameters loaded.
+	 */
+	double getQualityPrediction(const std::vector<
+	    std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>> &features)
+	    const;
+
+	/**
+	 * @brief
+	 * Retrieves NFIQ 2 quality score from dense feature values.
+	 *
+	 * @param featureVector
+	 * Values of the features consumed by the random forest.
+	 *
+	 * @return
+	 * Computed NFIQ 2 quality score.
+	 *
+	 * @throws Exception
+	 * Failure to compute (OpenCV reason contained within message string) or
+	 * called before random forest parameters loaded.
+	 */
+	double getQualityPrediction(
+	    const NFIQ2::FeatureVector &featureVector) const;
+
 	/**
 	 * @brief
 	 * Throw an exception if random forest parameters have not been
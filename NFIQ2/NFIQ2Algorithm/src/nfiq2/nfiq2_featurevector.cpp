@@ -0,0 +1,83 @@
+#include <nfiq2_exception.hpp>
+#include <nfiq2_featurevector.hpp>
+
+#include <string>
+#include <unordered_map>
+
+constexpr std::size_t NFIQ2::FeatureVector::Size;
+
+const std::array<std::string, NFIQ2::FeatureVector::Size> &
+NFIQ2::FeatureVector::getFeatureIDs()
+{
+	/**
+	   The following ordering of feature keys is critical to the
+	   correct computation of NFIQ 2 scores. Any modification to this
+	   ordering will result in incorrectly generated NFIQ 2 scores. This is
+	   based on the training model currently in use and may be updated in
+	   the future. It must match the order of FeatureIndex.
+	*/
+	static const std::array<std::string, Size> featureIDs { {
+		"FDA_Bin10_0", "FDA_Bin10_1", "FDA_Bin10_2", "FDA_Bin10_3",
+		"FDA_Bin10_4", "FDA_Bin10_5", "FDA_Bin10_6", "FDA_Bin10_7",
+		"FDA_Bin10_8", "FDA_Bin10_9", "FDA_Bin10_Mean",
+		"FDA_Bin10_StdDev", "FingerJetFX_MinCount_COMMinRect200x200",
+		"FingerJetFX_MinutiaeCount", "FJFXPos_Mu_MinutiaeQuality_2",
+		"FJFXPos_OCL_MinutiaeQuality_80", "ImgProcROIArea_Mean",
+		"LCS_Bin10_0", "LCS_Bin10_1", "LCS_Bin10_2", "LCS_Bin10_3",
+		"LCS_Bin10_4", "LCS_Bin10_5", "LCS_Bin10_6", "LCS_Bin10_7",
+		"LCS_Bin10_8", "LCS_Bin10_9", "LCS_Bin10_Mean",
+		"LCS_Bin10_StdDev", "MMB", "Mu", "OCL_Bin10_0", "OCL_Bin10_1",
+		"OCL_Bin10_2", "OCL_Bin10_3", "OCL_Bin10_4", "OCL_Bin10_5",
+		"OCL_Bin10_6", "OCL_Bin10_7", "OCL_Bin10_8", "OCL_Bin10_9",
+		"OCL_Bin10_Mean", "OCL_Bin10_StdDev", "OF_Bin10_0",
+		"OF_Bin10_1", "OF_Bin10_2", "OF_Bin10_3", "OF_Bin10_4",
+		"OF_Bin10_5", "OF_Bin10_6", "OF_Bin10_7", "OF_Bin10_8",
+		"OF_Bin10_9", "OF_Bin10_Mean", "OF_Bin10_StdDev",
+		"OrientationMap_ROIFilter_CoherenceRel",
+		"OrientationMap_ROIFilter_CoherenceSum", "RVUP_Bin10_0",
+		"RVUP_Bin10_1", "RVUP_Bin10_2", "RVUP_Bin10_3", "RVUP_Bin10_4",
+		"RVUP_Bin10_5", "RVUP_Bin10_6", "RVUP_Bin10_7", "RVUP_Bin10_8",
+		"RVUP_Bin10_9", "RVUP_Bin10_Mean", "RVUP_Bin10_StdDev" } };
+
+	return featureIDs;
+}
+
+NFIQ2::FeatureVector
+NFIQ2::FeatureVector::fromQualityFeatureData(
+    const std::unordered_map<std::string, NFIQ2::QualityFeatureData> &features)
+{
+	const std::array<std::string, Size> &featureIDs = getFeatureIDs();
+
+	FeatureVector featureVector {};
+	for (std::size_t i = 0; i < Size; i++) {
+		const auto it = features.find(featureIDs[i]);
+		if (it == features.cend()) {
+			throw NFIQ2::Exception(
+			    NFIQ2::ErrorCode::FeatureCalculationError,
+			    "Quality feature " + featureIDs[i] +
+				" is missing");
+		}
+		if (it->second.featureDataType ==
+		    e_QualityFeatureDataTypeDouble) {
+			featureVector.values[i] = it->second.featureDataDouble;
+		}
+	}
+
+	return featureVector;
+}
+
+std::unordered_map<std::string, NFIQ2::QualityFeatureData>
+NFIQ2::FeatureVector::toQualityFeatureData() const
+{
+	const std::array<std::string, Size> &featureIDs = getFeatureIDs();
+
+	std::unordered_map<std::string, NFIQ2::QualityFeatureData> features {};
+	for (std::size_t i = 0; i < Size; i++) {
+		NFIQ2::QualityFeatureData &feature = features[featureIDs[i]];
+		feature.featureID = featureIDs[i];
+		feature.featureDataType = e_QualityFeatureDataTypeDouble;
+		feature.featureDataDouble = this->values[i];
+	}
+
+	return features;
+}
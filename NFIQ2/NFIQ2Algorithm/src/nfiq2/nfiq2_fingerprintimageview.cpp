@@ -0,0 +1,204 @@
+#include <nfiq2_exception.hpp>
+#include <nfiq2_fingerprintimageview.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+NFIQ2::FingerprintImageView::FingerprintImageView(const uint8_t *pData,
+    uint32_t imageWidth, uint32_t imageHeight, uint32_t rowStride,
+    uint8_t fingerCode, uint16_t imageDPI)
+    : m_Data(pData)
+    , m_ImageWidth(imageWidth)
+    , m_ImageHeight(imageHeight)
+    , m_RowStride(rowStride)
+    , m_FingerCode(fingerCode)
+    , m_ImageDPI(imageDPI)
+{
+	if (pData == nullptr) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::BadArguments,
+		    "Fingerprint image view has no data");
+	}
+	if (rowStride < imageWidth) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::BadArguments,
+		    "Row stride of fingerprint image view (" +
+			std::to_string(rowStride) +
+			") is smaller than its width (" +
+			std::to_string(imageWidth) + ")");
+	}
+}
+
+NFIQ2::FingerprintImageView::FingerprintImageView(
+    const NFIQ2::FingerprintImageData &fingerprintImage)
+    : m_Data(fingerprintImage.data())
+    , m_ImageWidth(fingerprintImage.m_ImageWidth)
+    , m_ImageHeight(fingerprintImage.m_ImageHeight)
+    , m_RowStride(fingerprintImage.m_ImageWidth)
+    , m_FingerCode(fingerprintImage.m_FingerCode)
+    , m_ImageDPI(fingerprintImage.m_ImageDPI)
+{
+}
+
+NFIQ2::FingerprintImageData
+NFIQ2::FingerprintImageView::removeWhiteFrameAroundFingerprint() const
+{
+	cv::Mat img;
+	try {
+		// get matrix referencing the viewed pixels, which are only read
+		img = cv::Mat(this->m_ImageHeight, this->m_ImageWidth, CV_8UC1,
+		    (void *)this->m_Data, this->m_RowStride);
+	} catch (const cv::Exception &e) {
+		std::stringstream ssErr;
+		ssErr << "Cannot get matrix from fingerprint image: "
+		      << e.what();
+		throw NFIQ2::Exception(
+		    NFIQ2::ErrorCode::FeatureCalculationError, ssErr.str());
+	}
+
+	// sum the gray values (0 = black, 255 = white) of all rows and columns
+	// in a single pass, reading each row contiguously so that the
+	// column additions can be vectorized
+	std::vector<uint32_t> rowSums(img.rows, 0);
+	std::vector<uint32_t> columnSums(img.cols, 0);
+	for (int i = 0; i < img.rows; i++) {
+		const uchar *row = img.ptr<uchar>(i);
+		uint32_t *columnSum = columnSums.data();
+		uint32_t rowSum = 0;
+		for (int j = 0; j < img.cols; j++) {
+			rowSum += row[j];
+			columnSum[j] += row[j];
+		}
+		rowSums[i] = rowSum;
+	}
+
+	// start from top of image and find top row index that is already part
+	// of the fingerprint image
+	int topRowIndex = 0;
+	for (int i = 0; i < img.rows; i++) {
+		double mu = static_cast<double>(rowSums[i]) / img.cols;
+		if (mu <= MU_THRESHOLD) {
+			// Mu is not > threshold anymore -> top row index found
+			if (i == 0) {
+				topRowIndex = i;
+			} else {
+				topRowIndex = (i - 1);
+			}
+			break;
+		}
+	}
+
+	// start from bottom of image and find bottom row index that is already
+	// part of the fingerprint image
+	int bottomRowIndex = (img.rows - 1);
+	for (int i = (img.rows - 1); i >= 0; i--) {
+		double mu = static_cast<double>(rowSums[i]) / img.cols;
+		if (mu <= MU_THRESHOLD) {
+			// Mu is not > threshold anymore -> bottom row index
+			// found
+			if (i == (img.rows - 1)) {
+				bottomRowIndex = i;
+			} else {
+				bottomRowIndex = (i + 1);
+			}
+			break;
+		}
+	}
+
+	// start from left of image and find left index that is already part of
+	// the fingerprint image
+	int leftIndex = 0;
+	for (int j = 0; j < img.cols; j++) {
+		double mu = static_cast<double>(columnSums[j]) / img.rows;
+		if (mu <= MU_THRESHOLD) {
+			// Mu is not > threshold anymore -> left index found
+			if (j == 0) {
+				leftIndex = j;
+			} else {
+				leftIndex = (j - 1);
+			}
+			break;
+		}
+	}
+
+	// start from right of image and find right index that is already part
+	// of the fingerprint image
+	int rightIndex = (img.cols - 1);
+	for (int j = (img.cols - 1); j >= 0; j--) {
+		double mu = static_cast<double>(columnSums[j]) / img.rows;
+		if (mu <= MU_THRESHOLD) {
+			// Mu is not > threshold anymore -> right index found
+			if (j == (img.cols - 1)) {
+				rightIndex = j;
+			} else {
+				rightIndex = (j + 1);
+			}
+			break;
+		}
+	}
+
+	// now crop image according to detected border indices
+	int width = rightIndex - leftIndex + 1;
+	if (width <= 0) {
+		leftIndex = 0;
+		width = img.cols;
+	}
+	int height = bottomRowIndex - topRowIndex + 1;
+	if (height <= 0) {
+		topRowIndex = 0;
+		height = img.rows;
+	}
+	cv::Rect roi(leftIndex, topRowIndex, width, height);
+	cv::Mat roiImg = img(roi);
+
+	static const uint16_t fingerJetMinWidth = 196;
+	static const uint16_t fingerJetMaxWidth = 800;
+	static const uint16_t fingerJetMinHeight = 196;
+	static const uint16_t fingerJetMaxHeight = 1000;
+
+	// Values are from FJFX image size thresholds
+	if (roiImg.cols <= fingerJetMinWidth) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidImageSize,
+		    "Width is too small after trimming whitespace. WxH: " +
+			std::to_string(roiImg.cols) + "x" +
+			std::to_string(roiImg.rows) +
+			", but minimum width is " +
+			std::to_string(fingerJetMinWidth + 1));
+	} else if (roiImg.cols >= fingerJetMaxWidth) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidImageSize,
+		    "Width is too large after trimming whitespace. WxH: " +
+			std::to_string(roiImg.cols) + "x" +
+			std::to_string(roiImg.rows) +
+			", but maximum width is " +
+			std::to_string(fingerJetMaxWidth - 1));
+	} else if (roiImg.rows <= fingerJetMinHeight) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidImageSize,
+		    "Height is too small after trimming whitespace. WxH: " +
+			std::to_string(roiImg.cols) + "x" +
+			std::to_string(roiImg.rows) +
+			", but minimum height is " +
+			std::to_string(fingerJetMinHeight + 1));
+	} else if (roiImg.rows >= fingerJetMaxHeight) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidImageSize,
+		    "Height is too large after trimming whitespace. WxH: " +
+			std::to_string(roiImg.cols) + "x" +
+			std::to_string(roiImg.rows) +
+			", but maximum height is " +
+			std::to_string(fingerJetMaxHeight - 1));
+	}
+
+	NFIQ2::FingerprintImageData croppedImage;
+	croppedImage.m_ImageHeight = roiImg.rows;
+	croppedImage.m_ImageWidth = roiImg.cols;
+	croppedImage.m_FingerCode = this->m_FingerCode;
+	croppedImage.m_ImageDPI = this->m_ImageDPI;
+	// copy data now, which is the only copy of the pixels made
+	croppedImage.resize(roiImg.rows * roiImg.cols);
+	for (int i = 0; i < roiImg.rows; i++) {
+		memcpy((void *)(croppedImage.data() + (i * roiImg.cols)),
+		    roiImg.ptr<uchar>(i), roiImg.cols);
+	}
+
+	return croppedImage;
+}
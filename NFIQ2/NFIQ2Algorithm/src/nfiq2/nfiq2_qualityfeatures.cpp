@@ -29,6 +29,15 @@ NFIQ2::QualityFeatures::computeQualityFeatures(
 	return NFIQ2::QualityFeatures::Impl::computeQualityFeatures(rawImage);
 }
 
+std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
+NFIQ2::QualityFeatures::computeQualityFeatures(
+    const NFIQ2::FingerprintImageData &rawImage,
+    NFIQ2::QualityFeatures::ModuleExecution execution)
+{
+	return NFIQ2::QualityFeatures::Impl::computeQualityFeatures(
+	    rawImage, execution);
+}
+
 std::unordered_map<std::string, NFIQ2::ActionableQualityFeedback>
 NFIQ2::QualityFeatures::getActionableQualityFeedback(
     const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
@@ -60,6 +69,14 @@ NFIQ2::QualityFeatures::getQualityFeatureData(
 	return NFIQ2::QualityFeatures::Impl::getQualityFeatureData(rawImage);
 }
 
+NFIQ2::FeatureVector
+NFIQ2::QualityFeatures::getFeatureVector(
+    const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
+	&features)
+{
+	return NFIQ2::QualityFeatures::Impl::getFeatureVector(features);
+}
+
 std::unordered_map<std::string, NFIQ2::QualityFeatureSpeed>
 NFIQ2::QualityFeatures::getQualityFeatureSpeeds(
     const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
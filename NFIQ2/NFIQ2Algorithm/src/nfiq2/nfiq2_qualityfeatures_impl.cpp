@@ -2,11 +2,13 @@
 #include <features/FDAFeature.h>
 #include <features/FJFXMinutiaeQualityFeatures.h>
 #include <features/FingerJetFXFeature.h>
+#include <features/ImageAnalysisContext.h>
 #include <features/ImgProcROIFeature.h>
 #include <features/LCSFeature.h>
 #include <features/MuFeature.h>
 #include <features/OCLHistogramFeature.h>
 #include <features/OFFeature.h>
+#include <features/ParallelFor.h>
 #include <features/QualityMapFeatures.h>
 #include <features/RVUPHistogramFeature.h>
 #include <nfiq2_exception.hpp>
@@ -14,6 +16,7 @@
 #include <nfiq2_qualityfeatures.hpp>
 
 #include "nfiq2_qualityfeatures_impl.hpp"
+#include <functional>
 #include <iomanip>
 #include <list>
 #include <memory>
@@ -52,29 +55,46 @@ NFIQ2::QualityFeatures::Impl::getQualityFeatureData(
     const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
 	&features)
 {
-	std::vector<std::string> qualityIdentifiers =
-	    NFIQ2::QualityFeatures::Impl::getAllQualityFeatureIDs();
-
 	std::unordered_map<std::string, NFIQ2::QualityFeatureData> quality {};
 
-	auto counter = 0;
 	for (const auto &feature : features) {
-		for (auto &result : feature->getFeatures()) {
-			if (result.returnCode == 0) {
-				quality[qualityIdentifiers.at(counter)] =
-				    result.featureData;
-			} else {
-				result.featureData.featureDataDouble = 0;
-				quality[qualityIdentifiers.at(counter)] =
-				    result.featureData;
-			}
-			counter++;
+		for (const auto &result : feature->getFeatures()) {
+			quality[result.featureData.featureID] =
+			    result.featureData;
 		}
 	}
 
 	return quality;
 }
 
+NFIQ2::FeatureVector
+NFIQ2::QualityFeatures::Impl::getFeatureVector(
+    const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
+	&features)
+{
+	// modules store their results at their FeatureIndex
+	NFIQ2::FeatureVector featureVector {};
+
+	std::size_t counter = 0;
+	for (const auto &feature : features) {
+		counter += feature->copyFeatureValues(featureVector);
+	}
+
+	if (counter == 0) {
+		// no features have been computed
+		throw NFIQ2::Exception(
+		    NFIQ2::ErrorCode::FeatureCalculationError,
+		    "No features have been computed");
+	}
+	if (counter < NFIQ2::FeatureVector::Size) {
+		throw NFIQ2::Exception(
+		    NFIQ2::ErrorCode::FeatureCalculationError,
+		    "Not all quality features have been computed");
+	}
+
+	return featureVector;
+}
+
 std::unordered_map<std::string, NFIQ2::ActionableQualityFeedback>
 NFIQ2::QualityFeatures::Impl::getActionableQualityFeedback(
     const NFIQ2::FingerprintImageData &rawImage)
@@ -237,40 +257,151 @@ NFIQ2::QualityFeatures::Impl::computeQualityFeatures(
 	const NFIQ2::FingerprintImageData croppedImage =
 	    rawImage.removeWhiteFrameAroundFingerprint();
 
+	// intermediate results shared between the quality modules
+	const ImageAnalysisContext context(croppedImage);
+
+	return computeCroppedQualityFeatures(
+	    context, std::make_shared<MuFeature>(context));
+}
+
+std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
+NFIQ2::QualityFeatures::Impl::computeCroppedQualityFeatures(
+    const ImageAnalysisContext &context,
+    const std::shared_ptr<NFIQ2::QualityFeatures::MuFeature> &muFeatureModule)
+{
+	/* use double-precision rounding for 32-bit linux */
+	setFPU(0x27F);
+
+	const NFIQ2::FingerprintImageData &croppedImage =
+	    context.getFingerprintImage();
+
 	std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
 	    features {};
 
-	features.push_back(std::make_shared<FDAFeature>(croppedImage));
+	features.push_back(std::make_shared<FDAFeature>(context));
 
 	std::shared_ptr<FingerJetFXFeature> fjfxFeatureModule =
 	    std::make_shared<FingerJetFXFeature>(croppedImage);
 	features.push_back(fjfxFeatureModule);
 
 	features.push_back(std::make_shared<FJFXMinutiaeQualityFeature>(
-	    croppedImage, fjfxFeatureModule->getMinutiaData(),
+	    context, fjfxFeatureModule->getMinutiaData(),
 	    fjfxFeatureModule->getTemplateStatus()));
 
 	std::shared_ptr<ImgProcROIFeature> roiFeatureModule =
-	    std::make_shared<ImgProcROIFeature>(croppedImage);
+	    std::make_shared<ImgProcROIFeature>(context);
 	features.push_back(roiFeatureModule);
 
-	features.push_back(std::make_shared<LCSFeature>(croppedImage));
+	features.push_back(std::make_shared<LCSFeature>(context));
 
-	features.push_back(std::make_shared<MuFeature>(croppedImage));
+	features.push_back(muFeatureModule);
 
-	features.push_back(std::make_shared<OCLHistogramFeature>(croppedImage));
+	features.push_back(std::make_shared<OCLHistogramFeature>(context));
 
 	features.push_back(std::make_shared<OFFeature>(croppedImage));
 
 	features.push_back(std::make_shared<QualityMapFeatures>(
-	    croppedImage, roiFeatureModule->getImgProcResults()));
+	    context, roiFeatureModule->getImgProcResults()));
 
-	features.push_back(
-	    std::make_shared<RVUPHistogramFeature>(croppedImage));
+	features.push_back(std::make_shared<RVUPHistogramFeature>(context));
 
 	return features;
 }
 
+std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
+NFIQ2::QualityFeatures::Impl::computeQualityFeatures(
+    const NFIQ2::FingerprintImageData &rawImage,
+    NFIQ2::QualityFeatures::ModuleExecution execution)
+{
+	if (execution == ModuleExecution::Sequential) {
+		return computeQualityFeatures(rawImage);
+	}
+
+	/* use double-precision rounding for 32-bit linux */
+	setFPU(0x27F);
+
+	const NFIQ2::FingerprintImageData croppedImage =
+	    rawImage.removeWhiteFrameAroundFingerprint();
+
+	// intermediate results shared between the quality modules, computed
+	// with all hardware threads. The block loops of the modules below run
+	// sequentially, as the modules already run in parallel.
+	const ImageAnalysisContext context(croppedImage, 0);
+
+	std::shared_ptr<FDAFeature> fdaFeatureModule {};
+	std::shared_ptr<FingerJetFXFeature> fjfxFeatureModule {};
+	std::shared_ptr<FJFXMinutiaeQualityFeature> fjfxMinQualFeatureModule {};
+	std::shared_ptr<ImgProcROIFeature> roiFeatureModule {};
+	std::shared_ptr<LCSFeature> lcsFeatureModule {};
+	std::shared_ptr<MuFeature> muFeatureModule {};
+	std::shared_ptr<OCLHistogramFeature> oclFeatureModule {};
+	std::shared_ptr<OFFeature> ofFeatureModule {};
+	std::shared_ptr<QualityMapFeatures> qualityMapFeatureModule {};
+	std::shared_ptr<RVUPHistogramFeature> rvupFeatureModule {};
+
+	// Modules only depending on the image, longest running first
+	const std::vector<std::function<void()>> independentModules {
+		[&]() {
+			fjfxFeatureModule =
+			    std::make_shared<FingerJetFXFeature>(croppedImage);
+		},
+		[&]() {
+			roiFeatureModule = std::make_shared<ImgProcROIFeature>(
+			    context);
+		},
+		[&]() {
+			fdaFeatureModule = std::make_shared<FDAFeature>(
+			    context);
+		},
+		[&]() {
+			lcsFeatureModule = std::make_shared<LCSFeature>(
+			    context);
+		},
+		[&]() {
+			rvupFeatureModule =
+			    std::make_shared<RVUPHistogramFeature>(context);
+		},
+		[&]() {
+			ofFeatureModule = std::make_shared<OFFeature>(
+			    croppedImage);
+		},
+		[&]() {
+			oclFeatureModule =
+			    std::make_shared<OCLHistogramFeature>(context);
+		},
+		[&]() {
+			muFeatureModule = std::make_shared<MuFeature>(
+			    context);
+		}
+	};
+
+	// Modules depending on results of the modules above
+	const std::vector<std::function<void()>> dependentModules {
+		[&]() {
+			fjfxMinQualFeatureModule =
+			    std::make_shared<FJFXMinutiaeQualityFeature>(
+				context, fjfxFeatureModule->getMinutiaData(),
+				fjfxFeatureModule->getTemplateStatus());
+		},
+		[&]() {
+			qualityMapFeatureModule =
+			    std::make_shared<QualityMapFeatures>(context,
+				roiFeatureModule->getImgProcResults());
+		}
+	};
+
+	for (const auto modules : { &independentModules, &dependentModules }) {
+		parallelFor(static_cast<unsigned int>(modules->size()),
+		    [&](unsigned int i) { modules->at(i)(); });
+	}
+
+	// Same order as the sequential execution
+	return { fdaFeatureModule, fjfxFeatureModule, fjfxMinQualFeatureModule,
+		roiFeatureModule, lcsFeatureModule, muFeatureModule,
+		oclFeatureModule, ofFeatureModule, qualityMapFeatureModule,
+		rvupFeatureModule };
+}
+
 std::vector<std::string>
 NFIQ2::QualityFeatures::Impl::getAllActionableIdentifiers()
 {
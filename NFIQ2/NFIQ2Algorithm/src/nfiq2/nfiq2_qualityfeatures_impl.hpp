@@ -2,6 +2,9 @@
 #define NFIQ2_QUALITYFEATURES_IMPL_HPP_
 
 #include <features/BaseFeature.h>
+#include <features/ImageAnalysisContext.h>
+#include <features/MuFeature.h>
+#include <nfiq2_featurevector.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <nfiq2_qualityfeatures.hpp>
 
@@ -71,6 +74,43 @@ void setFPU(unsigned int mode);
 std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
 computeQualityFeatures(const NFIQ2::FingerprintImageData &rawImage);
 
+/**
+ * @brief
+ * Obtain computed quality feature data from a fingerprint image.
+ *
+ * @param rawImage
+ * Fingerprint image in raw format.
+ * @param execution
+ * How the quality modules are scheduled.
+ *
+ * @return
+ * A vector if BaseFeature modules containing computed feature data.
+ */
+std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
+computeQualityFeatures(const NFIQ2::FingerprintImageData &rawImage,
+    NFIQ2::QualityFeatures::ModuleExecution execution);
+
+/**
+ * @brief
+ * Obtain computed quality feature data from a fingerprint image whose white
+ * frame has already been removed, reusing its already computed Mu module.
+ *
+ * @param context
+ * Intermediate results of the fingerprint image returned by
+ * removeWhiteFrameAroundFingerprint(), shared by all modules.
+ * @param muFeatureModule
+ * Mu module computed from context.
+ *
+ * @return
+ * A vector if BaseFeature modules containing computed feature data, in the
+ * same order as returned by computeQualityFeatures().
+ */
+std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
+computeCroppedQualityFeatures(
+    const NFIQ2::QualityFeatures::ImageAnalysisContext &context,
+    const std::shared_ptr<NFIQ2::QualityFeatures::MuFeature>
+	&muFeatureModule);
+
 /**
  * @brief
  * Obtain actionable quality feedback from a vector of features.
@@ -127,6 +167,25 @@ getQualityFeatureData(
 std::unordered_map<std::string, NFIQ2::QualityFeatureData>
 getQualityFeatureData(const NFIQ2::FingerprintImageData &rawImage);
 
+/**
+ * @brief
+ * Obtain the features consumed by the random forest from a vector of
+ * features.
+ *
+ * @param features
+ * A vector of BaseFeatures obtained from a raw fingerprint image.
+ *
+ * @return
+ * Dense feature values, copied from the slots set by the modules.
+ *
+ * @throw NFIQ2::Exception
+ * No features or not all quality features have been computed.
+ */
+NFIQ2::FeatureVector
+getFeatureVector(
+    const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
+	&features);
+
 /**
  * @brief
  * Obtain quality feature speeds from a vector of features.
@@ -0,0 +1,684 @@
+#include <nfiq2_exception.hpp>
+#include <prediction/FlatRandomForest.h>
+
+#include "digestpp.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** Value of features missing from a sample (cv::ml::TrainData) */
+constexpr float MissingValue { FLT_MAX };
+
+/** Arrays of a forest converted from OpenCV */
+struct OwnedTables {
+	std::vector<int32_t> roots {};
+	std::vector<int32_t> depths {};
+	std::vector<int32_t> featureIndices {};
+	std::vector<float> thresholds {};
+	std::vector<int32_t> leftChildren {};
+	std::vector<uint8_t> missingRight {};
+	std::vector<double> values {};
+	std::vector<float> missingSubstitutes {};
+};
+
+/** Header of the binary format, followed by the arrays. */
+struct BinaryHeader {
+	/** FlatRandomForest::BinaryMagic */
+	char magic[8];
+	/** FlatRandomForest::BinaryVersion */
+	uint32_t version;
+	/** ByteOrderMark in the byte order of the writer */
+	uint32_t byteOrder;
+	uint32_t featureCount;
+	uint32_t treeCount;
+	uint32_t nodeCount;
+	/** featureCount if missing value substitutes follow, else 0 */
+	uint32_t substituteCount;
+	/** MD5 checksum of the parameters, padded with NUL */
+	char parameterHash[32];
+	/** MD5 checksum of all other bytes of the forest */
+	char checksum[32];
+};
+static_assert(sizeof(BinaryHeader) == 96, "Unexpected binary header size");
+
+constexpr uint32_t ByteOrderMark { 0x01020304 };
+
+/** Offsets of the arrays in the binary format. */
+struct BinaryLayout {
+	uint64_t roots {};
+	uint64_t depths {};
+	uint64_t featureIndices {};
+	uint64_t thresholds {};
+	uint64_t leftChildren {};
+	uint64_t missingRight {};
+	uint64_t values {};
+	uint64_t missingSubstitutes {};
+	/** size of the whole forest */
+	uint64_t size {};
+};
+
+/** @return offset rounded up to the alignment of the arrays */
+uint64_t
+alignOffset(const uint64_t offset)
+{
+	return (offset + 7) & ~static_cast<uint64_t>(7);
+}
+
+BinaryLayout
+getBinaryLayout(const uint64_t treeCount, const uint64_t nodeCount,
+    const uint64_t substituteCount)
+{
+	BinaryLayout layout {};
+	layout.roots = sizeof(BinaryHeader);
+	layout.depths = alignOffset(layout.roots + treeCount * 4);
+	layout.featureIndices = alignOffset(layout.depths + treeCount * 4);
+	layout.thresholds = alignOffset(layout.featureIndices + nodeCount * 4);
+	layout.leftChildren = alignOffset(layout.thresholds + nodeCount * 4);
+	layout.missingRight = alignOffset(layout.leftChildren + nodeCount * 4);
+	layout.values = alignOffset(layout.missingRight + nodeCount);
+	layout.missingSubstitutes = alignOffset(layout.values + nodeCount * 8);
+	layout.size = alignOffset(
+	    layout.missingSubstitutes + substituteCount * 4);
+	return layout;
+}
+
+/**
+ * @return
+ * MD5 checksum of the size bytes of a forest in the binary format, except
+ * BinaryHeader::checksum
+ */
+std::string
+calculateChecksum(const char *bytes, const std::size_t size)
+{
+	const std::size_t checksumOffset = offsetof(BinaryHeader, checksum);
+	const std::size_t payloadOffset =
+	    checksumOffset + sizeof(BinaryHeader::checksum);
+
+	digestpp::md5 hasher;
+	hasher.absorb(bytes, checksumOffset);
+	hasher.absorb(bytes + payloadOffset, size - payloadOffset);
+	return hasher.hexdigest();
+}
+
+/** Writes zeros up to offset, then size bytes of data */
+void
+writeArray(std::ostream &stream, uint64_t &position, const uint64_t offset,
+    const void *data, const uint64_t size)
+{
+	for (; position < offset; position++) {
+		stream.put('\0');
+	}
+	if (size != 0) {
+		stream.write(static_cast<const char *>(data),
+		    static_cast<std::streamsize>(size));
+		position += size;
+	}
+}
+
+}
+
+const char NFIQ2::Prediction::FlatRandomForest::BinaryMagic[8] { 'N', 'F',
+	'I', 'Q', '2', 'R', 'F', '\0' };
+
+const uint32_t NFIQ2::Prediction::FlatRandomForest::BinaryVersion { 2 };
+
+NFIQ2::Prediction::FlatRandomForest::FlatRandomForest() = default;
+
+NFIQ2::Prediction::FlatRandomForest::FlatRandomForest(
+    const cv::ml::DTrees &trees, const cv::FileNode &parameters,
+    const std::size_t featureCount)
+{
+	if (!trees.isTrained() || !trees.isClassifier()) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
+		    "The random forest is not a trained classifier");
+	}
+	if (static_cast<std::size_t>(trees.getVarCount()) != featureCount) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
+		    "The random forest expects " +
+			std::to_string(trees.getVarCount()) +
+			" features instead of " +
+			std::to_string(featureCount));
+	}
+
+	const std::shared_ptr<OwnedTables> owned =
+	    std::make_shared<OwnedTables>();
+
+	// a subset of variables would remap the features of the sample
+	std::vector<int> varIdx {};
+	if (!parameters["var_idx"].empty()) {
+		parameters["var_idx"] >> varIdx;
+	}
+	for (std::size_t i = 0; i < varIdx.size(); i++) {
+		if (varIdx[i] != static_cast<int>(i)) {
+			throw NFIQ2::Exception(
+			    NFIQ2::ErrorCode::InvalidConfiguration,
+			    "Random forests using a subset of variables are "
+			    "not supported");
+		}
+	}
+	if (!parameters["missing_subst"].empty()) {
+		parameters["missing_subst"] >> owned->missingSubstitutes;
+		if (owned->missingSubstitutes.size() < featureCount) {
+			throw NFIQ2::Exception(
+			    NFIQ2::ErrorCode::InvalidConfiguration,
+			    "Random forest has too few missing value "
+			    "substitutes");
+		}
+		owned->missingSubstitutes.resize(featureCount);
+	}
+
+	const std::vector<int> &cvRoots = trees.getRoots();
+	const std::vector<cv::ml::DTrees::Node> &cvNodes = trees.getNodes();
+	const std::vector<cv::ml::DTrees::Split> &cvSplits = trees.getSplits();
+
+	// OpenCV node of each flat node, numbered breadth first per tree
+	std::vector<int> order {};
+	order.reserve(cvNodes.size());
+	std::vector<int32_t> nodeDepths {};
+	for (const int cvRoot : cvRoots) {
+		const std::size_t root = order.size();
+		owned->roots.push_back(static_cast<int32_t>(root));
+		owned->depths.push_back(0);
+		order.push_back(cvRoot);
+		nodeDepths.assign(1, 0);
+
+		for (std::size_t i = root; i < order.size(); i++) {
+			if (order[i] < 0 ||
+			    static_cast<std::size_t>(order[i]) >=
+				cvNodes.size()) {
+				throw NFIQ2::Exception(
+				    NFIQ2::ErrorCode::InvalidConfiguration,
+				    "Random forest node " +
+					std::to_string(order[i]) +
+					" does not exist");
+			}
+			const cv::ml::DTrees::Node &node = cvNodes[order[i]];
+			const int32_t depth = nodeDepths[i - root];
+			owned->depths.back() = std::max(
+			    owned->depths.back(), depth);
+
+			if (node.split < 0) {
+				if (node.classIdx > 1) {
+					throw NFIQ2::Exception(
+					    NFIQ2::ErrorCode::
+						InvalidConfiguration,
+					    "Only two-class random forests "
+					    "are supported");
+				}
+				// no value is <= NaN, so leaves loop back
+				owned->featureIndices.push_back(0);
+				owned->thresholds.push_back(
+				    std::numeric_limits<float>::quiet_NaN());
+				owned->leftChildren.push_back(
+				    static_cast<int32_t>(i) - 1);
+				owned->missingRight.push_back(0);
+				owned->values.push_back(node.value);
+				continue;
+			}
+
+			const cv::ml::DTrees::Split &split =
+			    cvSplits.at(node.split);
+			if (split.subsetOfs >= 0) {
+				throw NFIQ2::Exception(
+				    NFIQ2::ErrorCode::InvalidConfiguration,
+				    "Random forests with categorical "
+				    "variables are not supported");
+			}
+			if (split.varIdx < 0 ||
+			    static_cast<std::size_t>(split.varIdx) >=
+				featureCount) {
+				throw NFIQ2::Exception(
+				    NFIQ2::ErrorCode::InvalidConfiguration,
+				    "Random forest splits on unknown "
+				    "feature " +
+					std::to_string(split.varIdx));
+			}
+
+			// cv::ml::DTrees ignores inversed for ordered splits
+			owned->featureIndices.push_back(split.varIdx);
+			owned->thresholds.push_back(split.c);
+			owned->leftChildren.push_back(
+			    static_cast<int32_t>(order.size()));
+			owned->missingRight.push_back(
+			    node.defaultDir < 0 ? 0 : 1);
+			owned->values.push_back(node.value);
+
+			order.push_back(node.left);
+			order.push_back(node.right);
+			nodeDepths.push_back(depth + 1);
+			nodeDepths.push_back(depth + 1);
+		}
+	}
+
+	this->tables.featureCount = featureCount;
+	this->tables.treeCount = owned->roots.size();
+	this->tables.nodeCount = owned->values.size();
+	this->tables.roots = owned->roots.data();
+	this->tables.depths = owned->depths.data();
+	this->tables.featureIndices = owned->featureIndices.data();
+	this->tables.thresholds = owned->thresholds.data();
+	this->tables.leftChildren = owned->leftChildren.data();
+	this->tables.missingRight = owned->missingRight.data();
+	this->tables.values = owned->values.data();
+	if (!owned->missingSubstitutes.empty()) {
+		this->tables.missingSubstitutes =
+		    owned->missingSubstitutes.data();
+	}
+	this->storage = owned;
+
+	this->validate();
+}
+
+NFIQ2::Prediction::FlatRandomForest::FlatRandomForest(
+    const Tables &tables, const std::shared_ptr<const void> &storage)
+    : tables { tables }
+    , storage { storage }
+{
+	this->validate();
+}
+
+NFIQ2::Prediction::FlatRandomForest::FlatRandomForest(const void *data,
+    const std::size_t size, const std::shared_ptr<const void> &storage)
+    : storage { storage }
+{
+	const char *bytes = static_cast<const char *>(data);
+	if (size < sizeof(BinaryHeader) || !isBinary(data, size)) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
+		    "The random forest is not in the binary format");
+	}
+	if (reinterpret_cast<uintptr_t>(data) % 8 != 0) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
+		    "The binary random forest is not aligned to 8 bytes");
+	}
+
+	BinaryHeader header {};
+	std::memcpy(&header, bytes, sizeof(header));
+	if (header.version != BinaryVersion) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
+		    "Binary random forest version " +
+			std::to_string(header.version) +
+			" is not supported");
+	}
+	if (header.byteOrder != ByteOrderMark) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
+		    "The binary random forest was written on a machine "
+		    "with another byte order");
+	}
+	if (header.substituteCount != 0 &&
+	    header.substituteCount != header.featureCount) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
+		    "The binary random forest has an invalid number of "
+		    "missing value substitutes");
+	}
+
+	const BinaryLayout layout = getBinaryLayout(
+	    header.treeCount, header.nodeCount, header.substituteCount);
+	if (layout.size != size) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
+		    "The binary random forest has " + std::to_string(size) +
+			" bytes instead of " + std::to_string(layout.size));
+	}
+	const std::string checksum(header.checksum, sizeof(header.checksum));
+	if (calculateChecksum(bytes, size) != checksum) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
+		    "The checksum of the binary random forest does not "
+		    "match its contents");
+	}
+
+	this->tables.featureCount = header.featureCount;
+	this->tables.treeCount = header.treeCount;
+	this->tables.nodeCount = header.nodeCount;
+	this->tables.roots = reinterpret_cast<const int32_t *>(
+	    bytes + layout.roots);
+	this->tables.depths = reinterpret_cast<const int32_t *>(
+	    bytes + layout.depths);
+	this->tables.featureIndices = reinterpret_cast<const int32_t *>(
+	    bytes + layout.featureIndices);
+	this->tables.thresholds = reinterpret_cast<const float *>(
+	    bytes + layout.thresholds);
+	this->tables.leftChildren = reinterpret_cast<const int32_t *>(
+	    bytes + layout.leftChildren);
+	this->tables.missingRight = reinterpret_cast<const uint8_t *>(
+	    bytes + layout.missingRight);
+	this->tables.values = reinterpret_cast<const double *>(
+	    bytes + layout.values);
+	if (header.substituteCount != 0) {
+		this->tables.missingSubstitutes =
+		    reinterpret_cast<const float *>(
+			bytes + layout.missingSubstitutes);
+	}
+	this->parameterHash.assign(header.parameterHash,
+	    strnlen(header.parameterHash, sizeof(header.parameterHash)));
+
+	this->validate();
+}
+
+NFIQ2::Prediction::FlatRandomForest::~FlatRandomForest() = default;
+
+NFIQ2::Prediction::FlatRandomForest
+NFIQ2::Prediction::FlatRandomForest::fromYAML(
+    const std::string &parameters, const std::size_t featureCount)
+{
+	// create file storage with parameters in memory
+	cv::FileStorage fs(parameters,
+	    cv::FileStorage::READ | cv::FileStorage::MEMORY |
+		cv::FileStorage::FORMAT_YAML);
+	const cv::FileNode node = fs["my_random_trees"];
+
+	// the OpenCV model is only needed to read the parameters
+	cv::Ptr<cv::ml::RTrees> trainedRF = cv::ml::RTrees::create();
+	trainedRF->read(node);
+	return FlatRandomForest(*trainedRF, node, featureCount);
+}
+
+bool
+NFIQ2::Prediction::FlatRandomForest::isBinary(
+    const void *data, const std::size_t size)
+{
+	return (size >= sizeof(BinaryMagic)) &&
+	    (std::memcmp(data, BinaryMagic, sizeof(BinaryMagic)) == 0);
+}
+
+void
+NFIQ2::Prediction::FlatRandomForest::write(
+    std::ostream &stream, const std::string &parameterHash) const
+{
+	BinaryHeader header {};
+	if (parameterHash.size() > sizeof(header.parameterHash)) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::BadArguments,
+		    "Parameter hash " + parameterHash + " is too long");
+	}
+	if (this->empty()) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::BadArguments,
+		    "An empty random forest cannot be written");
+	}
+
+	const Tables &t = this->tables;
+	std::memcpy(header.magic, BinaryMagic, sizeof(header.magic));
+	header.version = BinaryVersion;
+	header.byteOrder = ByteOrderMark;
+	header.featureCount = static_cast<uint32_t>(t.featureCount);
+	header.treeCount = static_cast<uint32_t>(t.treeCount);
+	header.nodeCount = static_cast<uint32_t>(t.nodeCount);
+	header.substituteCount = (t.missingSubstitutes != nullptr) ?
+	    header.featureCount :
+	    0;
+	std::memcpy(header.parameterHash, parameterHash.data(),
+	    parameterHash.size());
+
+	const uint64_t trees = t.treeCount;
+	const uint64_t nodes = t.nodeCount;
+	const BinaryLayout layout = getBinaryLayout(
+	    trees, nodes, header.substituteCount);
+
+	// the checksum covers the arrays, so they are written to memory first
+	std::ostringstream forest(std::ios::binary);
+	uint64_t position = 0;
+	writeArray(forest, position, 0, &header, sizeof(header));
+	writeArray(forest, position, layout.roots, t.roots, trees * 4);
+	writeArray(forest, position, layout.depths, t.depths, trees * 4);
+	writeArray(forest, position, layout.featureIndices, t.featureIndices,
+	    nodes * 4);
+	writeArray(forest, position, layout.thresholds, t.thresholds,
+	    nodes * 4);
+	writeArray(forest, position, layout.leftChildren, t.leftChildren,
+	    nodes * 4);
+	writeArray(forest, position, layout.missingRight, t.missingRight,
+	    nodes);
+	writeArray(forest, position, layout.values, t.values, nodes * 8);
+	writeArray(forest, position, layout.missingSubstitutes,
+	    t.missingSubstitutes,
+	    static_cast<uint64_t>(header.substituteCount) * 4);
+	writeArray(forest, position, layout.size, nullptr, 0);
+
+	std::string bytes = forest.str();
+	const std::string checksum = calculateChecksum(
+	    bytes.data(), bytes.size());
+	std::memcpy(&bytes[offsetof(BinaryHeader, checksum)],
+	    checksum.data(), sizeof(header.checksum));
+	stream.write(
+	    bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+	if (!stream) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::CannotWriteToFile,
+		    "The binary random forest could not be written");
+	}
+}
+
+std::string
+NFIQ2::Prediction::FlatRandomForest::getParameterHash() const
+{
+	return this->parameterHash;
+}
+
+void
+NFIQ2::Prediction::FlatRandomForest::validate() const
+{
+	const Tables &t = this->tables;
+	const auto invalid = [](const std::string &reason) {
+		return NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
+		    "Invalid random forest: " + reason);
+	};
+
+	if (t.treeCount == 0 || t.featureCount == 0) {
+		throw invalid("no trees or features");
+	}
+	if (t.nodeCount >
+	    static_cast<std::size_t>(std::numeric_limits<int32_t>::max())) {
+		throw invalid("too many nodes");
+	}
+
+	// descending never leaves the arrays: splits lead to later nodes and
+	// leaves loop back to themselves
+	for (std::size_t node = 0; node < t.nodeCount; node++) {
+		const int64_t self = static_cast<int64_t>(node);
+		const int64_t left = t.leftChildren[node];
+		const bool leaf = (left == self - 1) &&
+		    std::isnan(t.thresholds[node]);
+		const bool split = (left > self) &&
+		    (static_cast<uint64_t>(left) + 1 < t.nodeCount);
+		if ((!leaf && !split) || t.featureIndices[node] < 0 ||
+		    static_cast<std::size_t>(t.featureIndices[node]) >=
+			t.featureCount ||
+		    t.missingRight[node] > 1) {
+			throw invalid("node " + std::to_string(node));
+		}
+	}
+
+	// children follow their parent, so heights are known before the parent
+	// is visited, and a tree is descended exactly as many steps as needed
+	std::vector<int32_t> heights(t.nodeCount, 0);
+	for (std::size_t node = t.nodeCount; node-- > 0;) {
+		const int32_t left = t.leftChildren[node];
+		if (left > static_cast<int64_t>(node)) {
+			heights[node] = 1 +
+			    std::max(heights[left], heights[left + 1]);
+		}
+	}
+	for (std::size_t tree = 0; tree < t.treeCount; tree++) {
+		if (t.roots[tree] < 0 ||
+		    static_cast<std::size_t>(t.roots[tree]) >= t.nodeCount ||
+		    t.depths[tree] != heights[t.roots[tree]]) {
+			throw invalid("tree " + std::to_string(tree));
+		}
+	}
+}
+
+bool
+NFIQ2::Prediction::FlatRandomForest::empty() const
+{
+	return this->tables.treeCount == 0;
+}
+
+std::size_t
+NFIQ2::Prediction::FlatRandomForest::getFeatureCount() const
+{
+	return this->tables.featureCount;
+}
+
+const NFIQ2::Prediction::FlatRandomForest::Tables &
+NFIQ2::Prediction::FlatRandomForest::getTables() const
+{
+	return this->tables;
+}
+
+bool
+NFIQ2::Prediction::FlatRandomForest::hasMissingFeatures(
+    const float *sample) const
+{
+	const float *end = sample + this->tables.featureCount;
+	return std::find(sample, end, MissingValue) != end;
+}
+
+double
+NFIQ2::Prediction::FlatRandomForest::evaluate(const float *sample) const
+{
+	const Tables &t = this->tables;
+	const bool hasMissing = hasMissingFeatures(sample);
+
+	std::vector<float> substituted {};
+	if (hasMissing && t.missingSubstitutes != nullptr) {
+		substituted.assign(sample, sample + t.featureCount);
+		for (std::size_t i = 0; i < t.featureCount; i++) {
+			if (substituted[i] == MissingValue) {
+				substituted[i] = t.missingSubstitutes[i];
+			}
+		}
+		sample = substituted.data();
+	}
+
+	double sum = 0.0;
+	if (hasMissing && t.missingSubstitutes == nullptr) {
+		for (std::size_t tree = 0; tree < t.treeCount; tree++) {
+			sum += evaluateTreeWithMissing(t.roots[tree], sample);
+		}
+		return sum;
+	}
+
+	// descend four trees at once, each step is independent of the others
+	// and leaves loop back to themselves until all are reached
+	std::size_t tree = 0;
+	for (; tree + 4 <= t.treeCount; tree += 4) {
+		int32_t node0 = t.roots[tree];
+		int32_t node1 = t.roots[tree + 1];
+		int32_t node2 = t.roots[tree + 2];
+		int32_t node3 = t.roots[tree + 3];
+		const int32_t depth = std::max(
+		    std::max(t.depths[tree], t.depths[tree + 1]),
+		    std::max(t.depths[tree + 2], t.depths[tree + 3]));
+		for (int32_t step = 0; step < depth; step++) {
+			node0 = descend(node0, sample);
+			node1 = descend(node1, sample);
+			node2 = descend(node2, sample);
+			node3 = descend(node3, sample);
+		}
+
+		// sum in tree order, as cv::ml::DTrees does
+		sum += t.values[node0];
+		sum += t.values[node1];
+		sum += t.values[node2];
+		sum += t.values[node3];
+	}
+	for (; tree < t.treeCount; tree++) {
+		int32_t node = t.roots[tree];
+		for (int32_t step = 0; step < t.depths[tree]; step++) {
+			node = descend(node, sample);
+		}
+		sum += t.values[node];
+	}
+
+	return sum;
+}
+
+void
+NFIQ2::Prediction::FlatRandomForest::evaluate(const float *samples,
+    const std::size_t sampleCount, double *sums) const
+{
+	const Tables &t = this->tables;
+	const std::size_t featureCount = t.featureCount;
+	std::fill(sums, sums + sampleCount, 0.0);
+
+	// descend four samples at once through one tree at a time, which sums
+	// the leaves of each sample in tree order like evaluate() does
+	for (std::size_t tree = 0; tree < t.treeCount; tree++) {
+		const int32_t root = t.roots[tree];
+		const int32_t depth = t.depths[tree];
+
+		std::size_t i = 0;
+		for (; i + 4 <= sampleCount; i += 4) {
+			const float *sample0 = samples + i * featureCount;
+			const float *sample1 = sample0 + featureCount;
+			const float *sample2 = sample1 + featureCount;
+			const float *sample3 = sample2 + featureCount;
+			int32_t node0 = root, node1 = root;
+			int32_t node2 = root, node3 = root;
+			for (int32_t step = 0; step < depth; step++) {
+				node0 = descend(node0, sample0);
+				node1 = descend(node1, sample1);
+				node2 = descend(node2, sample2);
+				node3 = descend(node3, sample3);
+			}
+
+			sums[i] += t.values[node0];
+			sums[i + 1] += t.values[node1];
+			sums[i + 2] += t.values[node2];
+			sums[i + 3] += t.values[node3];
+		}
+		for (; i < sampleCount; i++) {
+			const float *sample = samples + i * featureCount;
+			int32_t node = root;
+			for (int32_t step = 0; step < depth; step++) {
+				node = descend(node, sample);
+			}
+			sums[i] += t.values[node];
+		}
+	}
+
+	// the few samples with missing features take the per sample path
+	for (std::size_t i = 0; i < sampleCount; i++) {
+		const float *sample = samples + i * featureCount;
+		if (hasMissingFeatures(sample)) {
+			sums[i] = evaluate(sample);
+		}
+	}
+}
+
+int32_t
+NFIQ2::Prediction::FlatRandomForest::descend(
+    const int32_t node, const float *sample) const
+{
+	const Tables &t = this->tables;
+	return t.leftChildren[node] +
+	    static_cast<int32_t>(
+		!(sample[t.featureIndices[node]] <= t.thresholds[node]));
+}
+
+double
+NFIQ2::Prediction::FlatRandomForest::evaluateTreeWithMissing(
+    const int32_t root, const float *sample) const
+{
+	const Tables &t = this->tables;
+
+	// children follow their parent, leaves point back
+	int32_t node = root;
+	while (t.leftChildren[node] > node) {
+		const float value = sample[t.featureIndices[node]];
+		if (value == MissingValue) {
+			node = t.leftChildren[node] + t.missingRight[node];
+		} else {
+			node = t.leftChildren[node] +
+			    static_cast<int32_t>(
+				!(value <= t.thresholds[node]));
+		}
+	}
+
+	return t.values[node];
+}
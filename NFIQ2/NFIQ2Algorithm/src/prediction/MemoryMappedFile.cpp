@@ -0,0 +1,125 @@
+#include <nfiq2_exception.hpp>
+#include <prediction/MemoryMappedFile.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <limits>
+#include <string>
+
+#ifdef _WIN32
+NFIQ2::Prediction::MemoryMappedFile::MemoryMappedFile(
+    const std::string &fileName)
+{
+	const HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ,
+	    FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+	    nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::CannotReadFromFile,
+		    "Could not open " + fileName);
+	}
+
+	LARGE_INTEGER fileSize {};
+	if (!GetFileSizeEx(file, &fileSize) ||
+	    static_cast<unsigned long long>(fileSize.QuadPart) >
+		std::numeric_limits<std::size_t>::max()) {
+		CloseHandle(file);
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::CannotReadFromFile,
+		    "Could not determine the size of " + fileName);
+	}
+	this->length = static_cast<std::size_t>(fileSize.QuadPart);
+	if (this->length == 0) {
+		CloseHandle(file);
+		return;
+	}
+
+	// the mapping keeps the file open
+	this->mapping = CreateFileMappingA(
+	    file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (this->mapping == nullptr) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::CannotReadFromFile,
+		    "Could not map " + fileName);
+	}
+
+	this->address = MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0);
+	if (this->address == nullptr) {
+		CloseHandle(this->mapping);
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::CannotReadFromFile,
+		    "Could not map " + fileName);
+	}
+}
+
+NFIQ2::Prediction::MemoryMappedFile::~MemoryMappedFile()
+{
+	if (this->address != nullptr) {
+		UnmapViewOfFile(this->address);
+	}
+	if (this->mapping != nullptr) {
+		CloseHandle(this->mapping);
+	}
+}
+#else
+NFIQ2::Prediction::MemoryMappedFile::MemoryMappedFile(
+    const std::string &fileName)
+{
+	const int file = open(fileName.c_str(), O_RDONLY);
+	if (file == -1) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::CannotReadFromFile,
+		    "Could not open " + fileName);
+	}
+
+	struct stat status {};
+	if (fstat(file, &status) != 0 || status.st_size < 0 ||
+	    static_cast<unsigned long long>(status.st_size) >
+		std::numeric_limits<std::size_t>::max()) {
+		close(file);
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::CannotReadFromFile,
+		    "Could not determine the size of " + fileName);
+	}
+	this->length = static_cast<std::size_t>(status.st_size);
+	if (this->length == 0) {
+		close(file);
+		return;
+	}
+
+	// the mapping stays valid after closing the file
+	void *mapped = mmap(
+	    nullptr, this->length, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+	if (mapped == MAP_FAILED) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::CannotReadFromFile,
+		    "Could not map " + fileName);
+	}
+	this->address = mapped;
+}
+
+NFIQ2::Prediction::MemoryMappedFile::~MemoryMappedFile()
+{
+	if (this->address != nullptr) {
+		munmap(const_cast<void *>(this->address), this->length);
+	}
+}
+#endif
+
+const void *
+NFIQ2::Prediction::MemoryMappedFile::data() const
+{
+	return this->address;
+}
+
+std::size_t
+NFIQ2::Prediction::MemoryMappedFile::size() const
+{
+	return this->length;
+}
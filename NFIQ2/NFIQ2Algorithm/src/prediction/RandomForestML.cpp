@@ -1,4 +1,6 @@
+#include <features/ParallelFor.h>
 #include <nfiq2_exception.hpp>
+#include <prediction/MemoryMappedFile.h>
 #include <prediction/RandomForestML.h>
 
 /*
@@ -9,26 +11,33 @@
 #ifdef NFIQ2_EMBEDDED_RANDOM_FOREST_PARAMETERS_FCT
 /* FRCT == Unknown */
 #if NFIQ2_EMBEDDED_RANDOM_FOREST_PARAMETERS_FCT == 0
-#include <prediction/RandomForestTrainedParams.h>
+#include <prediction/RandomForestEmbeddedModel.h>
 /* FRCT == scanned ink on paper */
 #elif NFIQ2_EMBEDDED_RANDOM_FOREST_PARAMETERS_FCT == 2
-#include <prediction/RandomForestTrainedParams.h>
+#include <prediction/RandomForestEmbeddedModel.h>
 /* FRCT == Optical: total internal reflection (bright field) */
 #elif NFIQ2_EMBEDDED_RANDOM_FOREST_PARAMETERS_FCT == 3
-#include <prediction/RandomForestTrainedParams.h>
+#include <prediction/RandomForestEmbeddedModel.h>
 /* Unsupported */
 #else
 #error Value of NFIQ2_EMBEDDED_RANDOM_FOREST_PARAMETERS_FCT is not supported.
 #endif /* NFIQ2_EMBEDDED_RANDOM_FOREST_PARAMETERS_FCT */
 #else
-#include <prediction/RandomForestTrainedParams.h>
+#include <prediction/RandomForestEmbeddedModel.h>
 #endif /* NFIQ2_EMBEDDED_RANDOM_FOREST_PARAMETERS_FCT */
 #endif /* NFIQ2_EMBED_RANDOM_FOREST_PARAMETERS */
 
 #include "digestpp.hpp"
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <ctime>
+#include <fstream>
+#include <limits>
+#include <memory>
 #include <numeric> // std::accumulate
+#include <string>
+#include <vector>
 
 std::string
 NFIQ2::Prediction::RandomForestML::calculateHashString(const std::string &s)
@@ -44,61 +53,49 @@ NFIQ2::Prediction::RandomForestML::calculateHashString(const std::string &s)
 void
 NFIQ2::Prediction::RandomForestML::initModule(const std::string &params)
 {
-	// create file storage with parameters in memory
-	cv::FileStorage fs(params.c_str(),
-	    cv::FileStorage::READ | cv::FileStorage::MEMORY |
-		cv::FileStorage::FORMAT_YAML);
-	// now import data structures
-	m_pTrainedRF = cv::ml::RTrees::create();
-	m_pTrainedRF->read(cv::FileNode(fs["my_random_trees"]));
+	m_forest = FlatRandomForest::fromYAML(
+	    params, NFIQ2::FeatureVector::Size);
 }
 
-#ifdef NFIQ2_EMBED_RANDOM_FOREST_PARAMETERS
-std::string
-NFIQ2::Prediction::RandomForestML::joinRFTrainedParamsString()
-{
-	unsigned int size = sizeof(g_strRandomForestTrainedParams) /
-	    sizeof(g_strRandomForestTrainedParams[0]);
-	std::string result = "";
-	for (unsigned int i = 0; i < size; i++) {
-		result.append(g_strRandomForestTrainedParams[i]);
-	}
-	return result;
-}
-#endif
-
 NFIQ2::Prediction::RandomForestML::RandomForestML()
 {
 }
 
-NFIQ2::Prediction::RandomForestML::~RandomForestML()
-{
-	if (!m_pTrainedRF.empty()) {
-		m_pTrainedRF->clear();
-	}
-}
+NFIQ2::Prediction::RandomForestML::~RandomForestML() = default;
 
 #ifdef NFIQ2_EMBED_RANDOM_FOREST_PARAMETERS
 std::string
 NFIQ2::Prediction::RandomForestML::initModule()
 {
-	try {
-		// get parameters from string
-		// accumulate it to a single string
-		// and decode base64
-		NFIQ2::Data data;
-		std::string params = joinRFTrainedParamsString();
-		unsigned int size = params.size();
-		data.fromBase64String(params);
-		params = "";
-		params.assign((const char *)data.data(), data.size());
-		initModule(params);
-		return calculateHashString(params);
-	} catch (const cv::Exception &e) {
-		throw Exception(NFIQ2::ErrorCode::UnknownError, e.msg);
-	} catch (...) {
-		throw;
-	}
+	namespace Model = NFIQ2::Prediction::EmbeddedModel;
+	static_assert(Model::FeatureCount == NFIQ2::FeatureVector::Size,
+	    "Embedded random forest has a different number of features");
+
+	// The generated arrays are referenced in place, nothing is parsed.
+	// They never change, so they are validated once, not per Algorithm.
+	static const FlatRandomForest embeddedForest = []() {
+		FlatRandomForest::Tables tables {};
+		tables.featureCount = Model::FeatureCount;
+		tables.treeCount = Model::TreeCount;
+		tables.nodeCount = Model::NodeCount;
+		tables.roots = Model::Roots;
+		tables.depths = Model::Depths;
+		tables.featureIndices = Model::FeatureIndices;
+		tables.thresholds = Model::Thresholds;
+		tables.leftChildren = Model::LeftChildren;
+		tables.missingRight = Model::MissingRight;
+		tables.values = Model::Values;
+		tables.missingSubstitutes = Model::MissingSubstitutes;
+
+		return FlatRandomForest(tables, nullptr);
+	}();
+
+	m_forest = embeddedForest;
+	m_parameterHash = Model::ParameterHash;
+#ifdef NFIQ2_EMBED_RANDOM_FOREST_CODE
+	m_generatedCode = true;
+#endif
+	return m_parameterHash;
 }
 #endif
 
@@ -106,99 +103,210 @@ std::string
 NFIQ2::Prediction::RandomForestML::initModule(
     const std::string &fileName, const std::string &fileHash)
 {
-	std::ifstream input(fileName);
-	std::string params((std::istreambuf_iterator<char>(input)),
-	    std::istreambuf_iterator<char>());
+	// binary models are used in place, the mapping lives as long as the
+	// forest referencing it
+	const std::shared_ptr<const MemoryMappedFile> file =
+	    std::make_shared<const MemoryMappedFile>(fileName);
+	if (FlatRandomForest::isBinary(file->data(), file->size())) {
+		FlatRandomForest forest(file->data(), file->size(), file);
+		if (forest.getFeatureCount() != NFIQ2::FeatureVector::Size) {
+			throw NFIQ2::Exception(
+			    NFIQ2::ErrorCode::InvalidConfiguration,
+			    "The random forest expects " +
+				std::to_string(forest.getFeatureCount()) +
+				" features instead of " +
+				std::to_string(NFIQ2::FeatureVector::Size));
+		}
+
+		// the header records the hash of the parameters it was
+		// converted from
+		const std::string hash = forest.getParameterHash();
+		if (fileHash.compare(hash) != 0) {
+			throw NFIQ2::Exception(
+			    NFIQ2::ErrorCode::InvalidConfiguration,
+			    "The trained network could not be initialized! "
+			    "Error: " +
+				hash);
+		}
+		m_forest = forest;
+		m_parameterHash = hash;
+		m_generatedCode = false;
+		return hash;
+	}
+
+	std::string params {};
+	if (file->size() != 0) {
+		params.assign(
+		    static_cast<const char *>(file->data()), file->size());
+	}
 	initModule(params);
 	// calculate and compare the hash
 	std::string hash = calculateHashString(params);
 	if (fileHash.compare(hash) != 0) {
-		m_pTrainedRF->clear();
+		m_forest = FlatRandomForest {};
 		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
 		    "The trained network could not be initialized! "
 		    "Error: " +
 			hash);
 	}
+	m_parameterHash = hash;
+	m_generatedCode = false;
 	return hash;
 }
 
+void
+NFIQ2::Prediction::RandomForestML::writeBinary(std::ostream &stream) const
+{
+	if (m_forest.empty()) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
+		    "The trained network could not be loaded for conversion!");
+	}
+	m_forest.write(stream, m_parameterHash);
+}
+
+void
+NFIQ2::Prediction::RandomForestML::writeBinary(
+    const std::string &fileName) const
+{
+	std::ofstream output(fileName, std::ios::binary | std::ios::trunc);
+	if (!output) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::CannotWriteToFile,
+		    "Could not open " + fileName);
+	}
+	writeBinary(output);
+	output.close();
+	if (!output) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::CannotWriteToFile,
+		    "Could not write " + fileName);
+	}
+}
+
+const std::vector<std::string> &
+NFIQ2::Prediction::RandomForestML::getFeatureOrder()
+{
+	static const std::vector<std::string> rfFeatureOrder(
+	    NFIQ2::FeatureVector::getFeatureIDs().cbegin(),
+	    NFIQ2::FeatureVector::getFeatureIDs().cend());
+
+	return rfFeatureOrder;
+}
+
 void
 NFIQ2::Prediction::RandomForestML::evaluate(
     const std::unordered_map<std::string, NFIQ2::QualityFeatureData> &features,
     double &qualityValue) const
 {
-	/**
-	   The following ordering of feature keys is critical to the
-	   correct computation of NFIQ 2 scores. Any modification to this
-	   ordering will result in incorrectly generated NFIQ 2 scores. This is
-	   based on the training model currently in use and may be updated in
-	   the future.
-	*/
-	static const std::vector<std::string> rfFeatureOrder { "FDA_Bin10_0",
-		"FDA_Bin10_1", "FDA_Bin10_2", "FDA_Bin10_3", "FDA_Bin10_4",
-		"FDA_Bin10_5", "FDA_Bin10_6", "FDA_Bin10_7", "FDA_Bin10_8",
-		"FDA_Bin10_9", "FDA_Bin10_Mean", "FDA_Bin10_StdDev",
-		"FingerJetFX_MinCount_COMMinRect200x200",
-		"FingerJetFX_MinutiaeCount", "FJFXPos_Mu_MinutiaeQuality_2",
-		"FJFXPos_OCL_MinutiaeQuality_80", "ImgProcROIArea_Mean",
-		"LCS_Bin10_0", "LCS_Bin10_1", "LCS_Bin10_2", "LCS_Bin10_3",
-		"LCS_Bin10_4", "LCS_Bin10_5", "LCS_Bin10_6", "LCS_Bin10_7",
-		"LCS_Bin10_8", "LCS_Bin10_9", "LCS_Bin10_Mean",
-		"LCS_Bin10_StdDev", "MMB", "Mu", "OCL_Bin10_0", "OCL_Bin10_1",
-		"OCL_Bin10_2", "OCL_Bin10_3", "OCL_Bin10_4", "OCL_Bin10_5",
-		"OCL_Bin10_6", "OCL_Bin10_7", "OCL_Bin10_8", "OCL_Bin10_9",
-		"OCL_Bin10_Mean", "OCL_Bin10_StdDev", "OF_Bin10_0",
-		"OF_Bin10_1", "OF_Bin10_2", "OF_Bin10_3", "OF_Bin10_4",
-		"OF_Bin10_5", "OF_Bin10_6", "OF_Bin10_7", "OF_Bin10_8",
-		"OF_Bin10_9", "OF_Bin10_Mean", "OF_Bin10_StdDev",
-		"OrientationMap_ROIFilter_CoherenceRel",
-		"OrientationMap_ROIFilter_CoherenceSum", "RVUP_Bin10_0",
-		"RVUP_Bin10_1", "RVUP_Bin10_2", "RVUP_Bin10_3", "RVUP_Bin10_4",
-		"RVUP_Bin10_5", "RVUP_Bin10_6", "RVUP_Bin10_7", "RVUP_Bin10_8",
-		"RVUP_Bin10_9", "RVUP_Bin10_Mean", "RVUP_Bin10_StdDev" };
-
-	std::vector<NFIQ2::QualityFeatureData> featureVector {};
-	for (const auto &i : rfFeatureOrder) {
-		featureVector.push_back(features.at(i));
+	evaluate(NFIQ2::FeatureVector::fromQualityFeatureData(features),
+	    qualityValue);
+}
+
+void
+NFIQ2::Prediction::RandomForestML::evaluate(
+    const std::vector<double> &featureValues, double &qualityValue) const
+{
+	if (featureValues.size() != NFIQ2::FeatureVector::Size) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::MachineLearningError,
+		    "Expected " + std::to_string(NFIQ2::FeatureVector::Size) +
+			" feature values but got " +
+			std::to_string(featureValues.size()));
 	}
 
-	try {
-		if (m_pTrainedRF.empty() || !m_pTrainedRF->isTrained() ||
-		    !m_pTrainedRF->isClassifier()) {
-			throw NFIQ2::Exception(
-			    NFIQ2::ErrorCode::InvalidConfiguration,
-			    "The trained network could not be loaded for "
-			    "prediction!");
-		}
+	NFIQ2::FeatureVector featureVector {};
+	std::copy(featureValues.cbegin(), featureValues.cend(),
+	    featureVector.values.begin());
 
-		// copy data to structure
-		cv::Mat sample_data = cv::Mat(
-		    1, featureVector.size(), CV_32FC1);
-		std::vector<NFIQ2::QualityFeatureData>::const_iterator it_feat;
-		unsigned int counterFeatures = 0;
-		for (it_feat = featureVector.begin();
-		     it_feat != featureVector.end(); it_feat++) {
-			if (it_feat->featureDataType ==
-			    e_QualityFeatureDataTypeDouble) {
-				sample_data.at<float>(0, counterFeatures) =
-				    (float)it_feat->featureDataDouble;
-			} else {
-				sample_data.at<float>(
-				    0, counterFeatures) = 0.0f;
-			}
-			counterFeatures++;
-		}
+	evaluate(featureVector, qualityValue);
+}
+
+void
+NFIQ2::Prediction::RandomForestML::evaluate(
+    const NFIQ2::FeatureVector &featureVector, double &qualityValue) const
+{
+	if (m_forest.empty()) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
+		    "The trained network could not be loaded for prediction!");
+	}
+
+	// the model compares single precision values
+	std::array<float, NFIQ2::FeatureVector::Size> sample {};
+	for (std::size_t i = 0; i < NFIQ2::FeatureVector::Size; i++) {
+		sample[i] = (float)featureVector.values[i];
+	}
+
+	// returns probability that between 0 and 1 that result belongs
+	// to second class
+	float prob = (float)evaluateSample(sample.data());
+	// return quality value
+	qualityValue = (int)(prob + 0.5);
+}
+
+void
+NFIQ2::Prediction::RandomForestML::evaluate(const double *featureMatrix,
+    const std::size_t sampleCount, std::vector<double> &qualityValues,
+    const unsigned int threadCount) const
+{
+	if (m_forest.empty()) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
+		    "The trained network could not be loaded for prediction!");
+	}
+
+	// chunks small enough for their samples to stay in L1 cache while
+	// the nodes of each tree are reused for all of them
+	static const std::size_t ChunkSize { 64 };
+	const std::size_t chunkCount = (sampleCount + ChunkSize - 1) /
+	    ChunkSize;
+	if (chunkCount > std::numeric_limits<unsigned int>::max()) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::BadArguments,
+		    "Too many samples to evaluate at once");
+	}
+
+	qualityValues.resize(sampleCount);
+	NFIQ2::QualityFeatures::parallelFor(
+	    static_cast<unsigned int>(chunkCount),
+	    [&](const unsigned int chunk) {
+		    const std::size_t first = chunk * ChunkSize;
+		    const std::size_t count = std::min(
+			ChunkSize, sampleCount - first);
+		    const double *rows = featureMatrix +
+			first * NFIQ2::FeatureVector::Size;
 
-		// returns probability that between 0 and 1 that result belongs
-		// to second class
-		float prob = m_pTrainedRF->predict(
-		    sample_data, cv::noArray(), cv::ml::StatModel::RAW_OUTPUT);
-		// return quality value
-		qualityValue = (int)(prob + 0.5);
+		    // the model compares single precision values
+		    std::array<float, ChunkSize * NFIQ2::FeatureVector::Size>
+			samples {};
+		    for (std::size_t i = 0;
+			 i < count * NFIQ2::FeatureVector::Size; i++) {
+			    samples[i] = (float)rows[i];
+		    }
 
-	} catch (const cv::Exception &e) {
-		throw Exception(NFIQ2::ErrorCode::MachineLearningError, e.msg);
+		    std::array<double, ChunkSize> sums {};
+		    if (m_generatedCode) {
+			    for (std::size_t i = 0; i < count; i++) {
+				    sums[i] = evaluateSample(
+					samples.data() +
+					i * NFIQ2::FeatureVector::Size);
+			    }
+		    } else {
+			    m_forest.evaluate(
+				samples.data(), count, sums.data());
+		    }
+		    for (std::size_t i = 0; i < count; i++) {
+			    float prob = (float)sums[i];
+			    qualityValues[first + i] = (int)(prob + 0.5);
+		    }
+	    },
+	    threadCount);
+}
+
+double
+NFIQ2::Prediction::RandomForestML::evaluateSample(const float *sample) const
+{
+#ifdef NFIQ2_EMBED_RANDOM_FOREST_CODE
+	// the generated code has no paths for missing features
+	if (m_generatedCode && !m_forest.hasMissingFeatures(sample)) {
+		return NFIQ2::Prediction::EmbeddedModel::evaluate(sample);
 	}
+#endif
+	return m_forest.evaluate(sample);
 }
 
 const std::string NFIQ2::Prediction::RandomForestML::moduleName {
@@ -0,0 +1,277 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+/*
+ * Scores the feature values of a compliance test output (e.g.,
+ * complianceTestSet/CTS_MASTER_OUTPUT.csv) with every random forest backend
+ * available in this build, reports the time per score and fails if a backend
+ * does not reproduce the scores of cv::ml::RTrees::predict(). Scores are also
+ * compared to those recorded in the file, whose features were rounded.
+ */
+
+#include <nfiq2_exception.hpp>
+#include <nfiq2_featurevector.hpp>
+#include <nfiq2_modelinfo.hpp>
+#include <nfiq2_timer.hpp>
+#include <opencv2/core.hpp>
+#include <opencv2/ml.hpp>
+#include <prediction/RandomForestML.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/** Feature values and score of each image of a compliance test output */
+struct ComplianceSet {
+	/** NFIQ2::FeatureVector::Size values per image */
+	std::vector<NFIQ2::FeatureVector> features {};
+	/** QualityScore of each image */
+	std::vector<unsigned int> scores {};
+};
+
+/** @return fields of a CSV line, without enclosing quotes */
+std::vector<std::string>
+splitCSVLine(const std::string &line)
+{
+	std::vector<std::string> fields(1);
+	bool quoted = false;
+	for (const char c : line) {
+		if (c == '"') {
+			quoted = !quoted;
+		} else if (c == ',' && !quoted) {
+			fields.emplace_back();
+		} else if (c != '\r') {
+			fields.back().push_back(c);
+		}
+	}
+	return fields;
+}
+
+/** Reads the images with a score and all features computed */
+ComplianceSet
+readComplianceSet(const std::string &fileName)
+{
+	std::ifstream input(fileName);
+	std::string line {};
+	if (!input || !std::getline(input, line)) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::CannotReadFromFile,
+		    "Could not read " + fileName);
+	}
+
+	std::unordered_map<std::string, std::size_t> columns {};
+	const std::vector<std::string> names = splitCSVLine(line);
+	for (std::size_t i = 0; i < names.size(); i++) {
+		columns[names[i]] = i;
+	}
+
+	const auto column = [&](const std::string &name) {
+		const auto found = columns.find(name);
+		if (found == columns.cend()) {
+			throw NFIQ2::Exception(NFIQ2::ErrorCode::BadArguments,
+			    fileName + " has no column " + name);
+		}
+		return found->second;
+	};
+	const std::size_t scoreColumn = column("QualityScore");
+	std::vector<std::size_t> featureColumns {};
+	for (const auto &id : NFIQ2::FeatureVector::getFeatureIDs()) {
+		featureColumns.push_back(column(id));
+	}
+
+	ComplianceSet set {};
+	while (std::getline(input, line)) {
+		const std::vector<std::string> fields = splitCSVLine(line);
+		if (fields.size() != names.size() ||
+		    fields[scoreColumn] == "NA") {
+			continue;
+		}
+
+		NFIQ2::FeatureVector featureVector {};
+		bool complete = true;
+		for (std::size_t i = 0; i < NFIQ2::FeatureVector::Size; i++) {
+			const std::string &field = fields[featureColumns[i]];
+			if (field.empty() || field == "NA") {
+				complete = false;
+				break;
+			}
+			featureVector.values[i] = std::stod(field);
+		}
+		if (complete) {
+			set.features.push_back(featureVector);
+			set.scores.push_back(static_cast<unsigned int>(
+			    std::stoul(fields[scoreColumn])));
+		}
+	}
+	return set;
+}
+
+/**
+ * Scores every image iterations times and prints the time per score.
+ *
+ * @return scores of the images
+ */
+std::vector<unsigned int>
+runBackend(const std::string &name, const ComplianceSet &set,
+    const unsigned int iterations,
+    const std::function<unsigned int(const NFIQ2::FeatureVector &)> &score)
+{
+	std::vector<unsigned int> scores(set.features.size());
+	NFIQ2::Timer timer {};
+	timer.start();
+	for (unsigned int iteration = 0; iteration < iterations;
+	     iteration++) {
+		for (std::size_t i = 0; i < set.features.size(); i++) {
+			scores[i] = score(set.features[i]);
+		}
+	}
+	const double microseconds = timer.stop() * 1000.0 /
+	    static_cast<double>(iterations * set.features.size());
+
+	std::cout << name << ": " << microseconds << " us per score\n";
+	return scores;
+}
+
+/** @return number of images whose scores differ */
+std::size_t
+countDifferences(const std::vector<unsigned int> &scores,
+    const std::vector<unsigned int> &reference)
+{
+	std::size_t differences = 0;
+	for (std::size_t i = 0; i < scores.size(); i++) {
+		if (scores[i] != reference[i]) {
+			differences++;
+		}
+	}
+	return differences;
+}
+
+}
+
+int
+main(int argc, char **argv)
+{
+	if (argc != 3 && argc != 4) {
+		std::cerr << "Usage: " << argv[0]
+			  << " <model info file> <compliance CSV> "
+			     "[iterations]\n";
+		return EXIT_FAILURE;
+	}
+
+	try {
+		const NFIQ2::ModelInfo modelInfo(argv[1]);
+		const ComplianceSet set = readComplianceSet(argv[2]);
+		const unsigned int iterations = (argc == 4) ?
+		    static_cast<unsigned int>(std::stoul(argv[3])) :
+		    100;
+		if (set.features.empty() || iterations == 0) {
+			throw NFIQ2::Exception(NFIQ2::ErrorCode::BadArguments,
+			    "Nothing to score");
+		}
+		std::cout << set.features.size() << " images, " << iterations
+			  << " iterations\n";
+
+		// reference: the OpenCV model the backends are converted from
+		std::ifstream input(modelInfo.getModelPath());
+		const std::string params(
+		    (std::istreambuf_iterator<char>(input)),
+		    std::istreambuf_iterator<char>());
+		cv::FileStorage fs(params,
+		    cv::FileStorage::READ | cv::FileStorage::MEMORY |
+			cv::FileStorage::FORMAT_YAML);
+		cv::Ptr<cv::ml::RTrees> trainedRF = cv::ml::RTrees::create();
+		trainedRF->read(fs["my_random_trees"]);
+		if (!trainedRF->isTrained()) {
+			throw NFIQ2::Exception(
+			    NFIQ2::ErrorCode::InvalidConfiguration,
+			    "The OpenCV path needs the YAML model, not " +
+				modelInfo.getModelPath());
+		}
+
+		cv::Mat sample(1, NFIQ2::FeatureVector::Size, CV_32FC1);
+		const std::vector<unsigned int> reference = runBackend(
+		    "cv::ml::RTrees", set, iterations,
+		    [&](const NFIQ2::FeatureVector &featureVector) {
+			    for (std::size_t i = 0;
+				 i < NFIQ2::FeatureVector::Size; i++) {
+				    sample.at<float>(0, static_cast<int>(i)) =
+					(float)featureVector.values[i];
+			    }
+			    float prob = trainedRF->predict(sample,
+				cv::noArray(),
+				cv::ml::StatModel::RAW_OUTPUT);
+			    return static_cast<unsigned int>(
+				(int)(prob + 0.5));
+		    });
+
+		std::vector<std::pair<std::string,
+		    NFIQ2::Prediction::RandomForestML>>
+		    backends {};
+		backends.emplace_back("Node arrays",
+		    NFIQ2::Prediction::RandomForestML {});
+		backends.back().second.initModule(
+		    modelInfo.getModelPath(), modelInfo.getModelHash());
+#ifdef NFIQ2_EMBED_RANDOM_FOREST_PARAMETERS
+#ifdef NFIQ2_EMBED_RANDOM_FOREST_CODE
+		const std::string embeddedName { "Embedded generated code" };
+#else
+		const std::string embeddedName { "Embedded node arrays" };
+#endif
+		NFIQ2::Prediction::RandomForestML embedded {};
+		if (embedded.initModule() == modelInfo.getModelHash()) {
+			backends.emplace_back(embeddedName, embedded);
+		} else {
+			std::cout << embeddedName
+				  << ": skipped, built from another model\n";
+		}
+#endif
+
+		bool identical = true;
+		for (const auto &backend : backends) {
+			const std::vector<unsigned int> scores = runBackend(
+			    backend.first, set, iterations,
+			    [&](const NFIQ2::FeatureVector &featureVector) {
+				    double qualityValue {};
+				    backend.second.evaluate(
+					featureVector, qualityValue);
+				    return static_cast<unsigned int>(
+					qualityValue);
+			    });
+			const std::size_t differences = countDifferences(
+			    scores, reference);
+			std::cout << backend.first << ": " << differences
+				  << " scores differ from cv::ml::RTrees\n";
+			identical = identical && (differences == 0);
+		}
+
+		// features in the file are rounded, which may change scores
+		std::cout << countDifferences(reference, set.scores)
+			  << " scores differ from " << argv[2] << '\n';
+
+		if (!identical) {
+			return EXIT_FAILURE;
+		}
+	} catch (const cv::Exception &e) {
+		std::cerr << e.msg << '\n';
+		return EXIT_FAILURE;
+	} catch (const NFIQ2::Exception &e) {
+		std::cerr << e.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+/*
+ * Compares ImgProcROIFeature::gaussianBlurRows() to cv::GaussianBlur for the
+ * kernel sizes of the ROI segmentation (41 and 91) on generated grayscale and
+ * binary images, with several thread counts, and fails if any pixel differs.
+ * Heights start below the kernel radius, so that the rows near the image
+ * borders are covered, and binary images have uniform rows at their borders
+ * as well as in between.
+ */
+
+#include <features/ImgProcROIFeature.h>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+/** Kernel sizes of ImgProcROIFeature::computeROI() */
+constexpr int KernelSizes[] { 41, 91 };
+/** Thread counts, i.e., numbers of bands, to compare */
+constexpr unsigned int ThreadCounts[] { 1, 2, 3, 8 };
+
+/** @return image of random gray values */
+cv::Mat
+makeGrayImage(cv::RNG &rng, const int rows, const int cols)
+{
+	cv::Mat image(rows, cols, CV_8UC1);
+	rng.fill(image, cv::RNG::UNIFORM, 0, 256);
+	return image;
+}
+
+/**
+ * @return
+ * white image with a black ellipse and black noise, as segmented by the
+ * first Otsu threshold
+ */
+cv::Mat
+makeBinaryImage(cv::RNG &rng, const int rows, const int cols)
+{
+	cv::Mat image(rows, cols, CV_8UC1, cv::Scalar(255));
+	const cv::Point center(rng.uniform(0, cols), rng.uniform(0, rows));
+	const cv::Size axes(rng.uniform(1, cols + 1), rng.uniform(1, rows + 1));
+	cv::ellipse(image, center, axes, 0.0, 0.0, 360.0, cv::Scalar(0),
+	    cv::FILLED);
+
+	if (rng.uniform(0, 2) == 1) {
+		for (int i = 0; i < rows * cols / 100; i++) {
+			image.at<uint8_t>(rng.uniform(0, rows),
+			    rng.uniform(0, cols)) = 0;
+		}
+	}
+	if (rng.uniform(0, 2) == 1) {
+		// uniform black stripe, followed by mixed rows
+		const int top = rng.uniform(0, rows);
+		image.rowRange(top, rng.uniform(top, rows) + 1)
+		    .setTo(cv::Scalar(0));
+	}
+	return image;
+}
+
+/** Blurs image in bands and counts the pixels differing from OpenCV */
+int
+countDifferences(const cv::Mat &image, const int ksize,
+    const bool binaryInput, const unsigned int threadCount)
+{
+	cv::Mat reference;
+	cv::GaussianBlur(image, reference, cv::Size(ksize, ksize), 0.0);
+
+	cv::Mat result;
+	NFIQ2::QualityFeatures::ImgProcROIFeature::gaussianBlurRows(
+	    image, result, ksize, binaryInput, threadCount);
+
+	if ((result.size() != reference.size()) ||
+	    (result.type() != reference.type())) {
+		return image.rows * image.cols;
+	}
+	return cv::countNonZero(result != reference);
+}
+
+}
+
+int
+main(int argc, char **argv)
+{
+	if (argc > 2) {
+		std::cerr << "Usage: " << argv[0] << " [images per case]\n";
+		return EXIT_FAILURE;
+	}
+	const int imageCount = (argc == 2) ? std::stoi(argv[1]) : 200;
+
+	bool identical = true;
+	try {
+		for (const bool binary : { false, true }) {
+			for (const int ksize : KernelSizes) {
+				// same images for all thread counts
+				cv::RNG rng(static_cast<uint64_t>(ksize));
+				int differingImages = 0;
+				for (int i = 0; i < imageCount; i++) {
+					// all rows are within the radius of a
+					// border for the first images
+					const int rows = (i < ksize) ?
+					    i + 1 :
+					    rng.uniform(ksize, 700);
+					const int cols = rng.uniform(1, 700);
+					const cv::Mat image = binary ?
+					    makeBinaryImage(rng, rows, cols) :
+					    makeGrayImage(rng, rows, cols);
+
+					bool differs = false;
+					for (const unsigned int threadCount :
+					    ThreadCounts) {
+						differs = differs ||
+						    (countDifferences(image,
+							 ksize, binary,
+							 threadCount) != 0);
+					}
+					if (differs) {
+						differingImages++;
+					}
+				}
+
+				std::cout << (binary ? "binary" : "grayscale")
+					  << ", kernel size " << ksize << ": "
+					  << differingImages << " of "
+					  << imageCount
+					  << " images differ from "
+					     "cv::GaussianBlur\n";
+				identical = identical && (differingImages == 0);
+			}
+		}
+	} catch (const cv::Exception &e) {
+		std::cerr << e.msg << '\n';
+		return EXIT_FAILURE;
+	}
+
+	return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
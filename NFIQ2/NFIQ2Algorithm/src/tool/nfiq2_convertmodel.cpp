@@ -0,0 +1,52 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+/*
+ * Converts random forest parameters referenced by a model info file into the
+ * binary model format, which NFIQ2::Algorithm memory maps instead of parsing.
+ * Point the Path of a copy of the model info file to the binary model and
+ * keep its Hash, which the binary model records.
+ */
+
+#include <nfiq2_exception.hpp>
+#include <nfiq2_modelinfo.hpp>
+#include <prediction/RandomForestML.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int
+main(int argc, char **argv)
+{
+	if (argc != 3) {
+		std::cerr << "Usage: " << argv[0]
+			  << " <model info file> <binary model file>\n";
+		return EXIT_FAILURE;
+	}
+
+	try {
+		const NFIQ2::ModelInfo modelInfo(argv[1]);
+
+		NFIQ2::Prediction::RandomForestML forest {};
+		const std::string hash = forest.initModule(
+		    modelInfo.getModelPath(), modelInfo.getModelHash());
+		forest.writeBinary(std::string(argv[2]));
+
+		std::cout << "Wrote " << argv[2] << " from "
+			  << modelInfo.getModelPath() << " (" << hash
+			  << ")\n";
+	} catch (const NFIQ2::Exception &e) {
+		std::cerr << e.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
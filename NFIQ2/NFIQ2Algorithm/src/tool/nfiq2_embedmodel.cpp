@@ -0,0 +1,258 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+/*
+ * Build step of EMBED_RANDOM_FOREST_PARAMETERS: converts YAML random forest
+ * parameters into a header of constexpr node arrays and the MD5 checksum of
+ * the parameters, which RandomForestML::initModule() references directly.
+ * With --code (EMBED_RANDOM_FOREST_CODE), each tree is also written as nested
+ * comparisons, which RandomForestML evaluates instead of the arrays.
+ */
+
+#include <nfiq2_exception.hpp>
+#include <nfiq2_featurevector.hpp>
+#include <prediction/FlatRandomForest.h>
+
+#include "digestpp.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+namespace {
+
+/** Number of array elements per line of the header */
+constexpr std::size_t ValuesPerLine { 6 };
+
+/** @return decimal with at least one fraction digit or an exponent */
+std::string
+toDecimal(const double value, const int precision)
+{
+	char decimal[32] {};
+	std::snprintf(decimal, sizeof(decimal), "%.*g", precision, value);
+	const std::string result(decimal);
+	return (result.find_first_of(".e") == std::string::npos) ?
+	    result + ".0" :
+	    result;
+}
+
+/** @return literal reading back as exactly value */
+std::string
+toLiteral(const float value)
+{
+	if (std::isnan(value)) {
+		return "NaN";
+	}
+	if (std::isinf(value)) {
+		return std::string(value < 0 ? "-" : "") +
+		    "std::numeric_limits<float>::infinity()";
+	}
+	return toDecimal(value, 9) + "f";
+}
+
+/** @return literal reading back as exactly value */
+std::string
+toLiteral(const double value)
+{
+	if (std::isnan(value)) {
+		return "std::numeric_limits<double>::quiet_NaN()";
+	}
+	if (std::isinf(value)) {
+		return std::string(value < 0 ? "-" : "") +
+		    "std::numeric_limits<double>::infinity()";
+	}
+	return toDecimal(value, 17);
+}
+
+std::string
+toLiteral(const int32_t value)
+{
+	return std::to_string(value);
+}
+
+std::string
+toLiteral(const uint8_t value)
+{
+	return std::to_string(static_cast<unsigned int>(value));
+}
+
+template <typename T>
+void
+writeArray(std::ostream &header, const std::string &type,
+    const std::string &name, const T *values, const std::size_t count)
+{
+	header << "constexpr " << type << ' ' << name << "[] {";
+	for (std::size_t i = 0; i < count; i++) {
+		header << ((i % ValuesPerLine == 0) ? "\n\t" : " ")
+		       << toLiteral(values[i]) << (i + 1 < count ? "," : "");
+	}
+	header << "\n};\n\n";
+}
+
+/** Writes the subtree starting at node as nested comparisons */
+void
+writeSubtree(std::ostream &header,
+    const NFIQ2::Prediction::FlatRandomForest::Tables &t, const int32_t node,
+    const std::string &indent)
+{
+	const int32_t left = t.leftChildren[node];
+	if (left < node) {
+		header << indent << "return " << toLiteral(t.values[node])
+		       << ";\n";
+		return;
+	}
+
+	// samples not lower or equal, including NaN, go right as in the arrays
+	header << indent << "if (x[" << t.featureIndices[node]
+	       << "] <= " << toLiteral(t.thresholds[node]) << ") {\n";
+	writeSubtree(header, t, left, indent + '\t');
+	header << indent << "} else {\n";
+	writeSubtree(header, t, left + 1, indent + '\t');
+	header << indent << "}\n";
+}
+
+/** Writes one function per tree and evaluate() summing them */
+void
+writeCode(std::ostream &header,
+    const NFIQ2::Prediction::FlatRandomForest::Tables &t)
+{
+	for (std::size_t tree = 0; tree < t.treeCount; tree++) {
+		header << "/** Value of the leaf of tree " << tree
+		       << " reached by x */\n"
+		       << "inline double\n"
+		       << "tree" << tree << "(const float *x)\n"
+		       << "{\n";
+		writeSubtree(header, t, t.roots[tree], "\t");
+		header << "}\n\n";
+	}
+
+	header << "/**\n"
+	       << " * Sum of the leaves reached by x in all trees, in tree\n"
+	       << " * order, for samples without missing features.\n"
+	       << " */\n"
+	       << "inline double\n"
+	       << "evaluate(const float *x)\n"
+	       << "{\n"
+	       << "\tdouble sum = 0.0;\n";
+	for (std::size_t tree = 0; tree < t.treeCount; tree++) {
+		header << "\tsum += tree" << tree << "(x);\n";
+	}
+	header << "\treturn sum;\n"
+	       << "}\n\n";
+}
+
+}
+
+int
+main(int argc, char **argv)
+{
+	const bool code = (argc == 4) && (std::string(argv[1]) == "--code");
+	if (argc != 3 && !code) {
+		std::cerr << "Usage: " << argv[0]
+			  << " [--code] <YAML model file> <header file>\n";
+		return EXIT_FAILURE;
+	}
+	const std::string modelFileName { argv[argc - 2] };
+	const std::string headerFileName { argv[argc - 1] };
+
+	try {
+		std::ifstream input(modelFileName, std::ios::binary);
+		if (!input) {
+			throw NFIQ2::Exception(
+			    NFIQ2::ErrorCode::CannotReadFromFile,
+			    "Could not open " + modelFileName);
+		}
+		const std::string params(
+		    (std::istreambuf_iterator<char>(input)),
+		    std::istreambuf_iterator<char>());
+
+		// same checksum as RandomForestML computes for the YAML
+		digestpp::md5 hasher;
+		const std::string hash =
+		    hasher.absorb(params.c_str(), params.length()).hexdigest();
+
+		const NFIQ2::Prediction::FlatRandomForest forest =
+		    NFIQ2::Prediction::FlatRandomForest::fromYAML(
+			params, NFIQ2::FeatureVector::Size);
+		const NFIQ2::Prediction::FlatRandomForest::Tables &t =
+		    forest.getTables();
+
+		std::ofstream header(headerFileName, std::ios::trunc);
+		header << "/* Generated by nfiq2-embed-model, do not edit. */\n"
+		       << "\n"
+		       << "#ifndef RANDOMFORESTEMBEDDEDMODEL_H\n"
+		       << "#define RANDOMFORESTEMBEDDEDMODEL_H\n"
+		       << "\n"
+		       << "#include <cstddef>\n"
+		       << "#include <cstdint>\n"
+		       << "#include <limits>\n"
+		       << "\n"
+		       << "namespace NFIQ2 { namespace Prediction {\n"
+		       << "namespace EmbeddedModel {\n"
+		       << "\n"
+		       << "/** Threshold of leaves */\n"
+		       << "constexpr float NaN { "
+		       << "std::numeric_limits<float>::quiet_NaN() };\n"
+		       << "\n"
+		       << "constexpr char ParameterHash[] { \"" << hash
+		       << "\" };\n"
+		       << "constexpr std::size_t FeatureCount { "
+		       << t.featureCount << " };\n"
+		       << "constexpr std::size_t TreeCount { " << t.treeCount
+		       << " };\n"
+		       << "constexpr std::size_t NodeCount { " << t.nodeCount
+		       << " };\n"
+		       << "\n";
+		writeArray(header, "int32_t", "Roots", t.roots, t.treeCount);
+		writeArray(header, "int32_t", "Depths", t.depths, t.treeCount);
+		writeArray(header, "int32_t", "FeatureIndices",
+		    t.featureIndices, t.nodeCount);
+		writeArray(header, "float", "Thresholds", t.thresholds,
+		    t.nodeCount);
+		writeArray(header, "int32_t", "LeftChildren", t.leftChildren,
+		    t.nodeCount);
+		writeArray(header, "uint8_t", "MissingRight", t.missingRight,
+		    t.nodeCount);
+		writeArray(header, "double", "Values", t.values, t.nodeCount);
+		if (t.missingSubstitutes != nullptr) {
+			writeArray(header, "float", "MissingSubstitutes",
+			    t.missingSubstitutes, t.featureCount);
+		} else {
+			header << "constexpr const float *MissingSubstitutes "
+				  "{ nullptr };\n\n";
+		}
+		if (code) {
+			writeCode(header, t);
+		}
+		header << "}\n"
+		       << "}}\n"
+		       << "\n"
+		       << "#endif /* RANDOMFORESTEMBEDDEDMODEL_H */\n";
+
+		header.close();
+		if (!header) {
+			throw NFIQ2::Exception(
+			    NFIQ2::ErrorCode::CannotWriteToFile,
+			    "Could not write " + headerFileName);
+		}
+	} catch (const cv::Exception &e) {
+		std::cerr << e.msg << '\n';
+		return EXIT_FAILURE;
+	} catch (const NFIQ2::Exception &e) {
+		std::cerr << e.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -354,21 +354,44 @@ NFIQ2UI::executeSingle(std::shared_ptr<BE::Image::Image> img,
 	// At this point - all images are 500PPI, have been converted to that
 	// resolution, or are assumed to be that resolution.
 
-	const NFIQ2::FingerprintImageData wrappedImage = imageProps.resampled ?
-		  NFIQ2::FingerprintImageData(postResample.data, postResample.total(),
-		postResample.cols, postResample.rows, fingerPosition,
-		requiredDPI) :
-		  NFIQ2::FingerprintImageData(grayscaleRawData,
-		grayscaleRawData.size(), imageWidth, imageHeight,
-		fingerPosition, requiredDPI);
+	// Feature data, speeds, and actionable feedback are only needed when
+	// they are printed
+	const bool scoreOnly = !(
+	    flags.verbose || flags.speed || flags.actionable);
 
 	std::vector<std::shared_ptr<NFIQ2::QualityFeatures::BaseFeature>>
 	    features {};
 	unsigned int score {};
 	try {
-		features = NFIQ2::QualityFeatures::computeQualityFeatures(
-		    wrappedImage);
-		score = model.computeQualityScore(features);
+		if (scoreOnly) {
+			// Score the pixels in place
+			const NFIQ2::FingerprintImageView imageView =
+			    imageProps.resampled ?
+			    NFIQ2::FingerprintImageView(postResample.data,
+				postResample.cols, postResample.rows,
+				static_cast<uint32_t>(postResample.step),
+				fingerPosition, requiredDPI) :
+			    NFIQ2::FingerprintImageView(grayscaleRawData,
+				imageWidth, imageHeight, imageWidth,
+				fingerPosition, requiredDPI);
+
+			score = model.computeQualityScore(imageView);
+		} else {
+			const NFIQ2::FingerprintImageData wrappedImage =
+			    imageProps.resampled ?
+			    NFIQ2::FingerprintImageData(postResample.data,
+				postResample.total(), postResample.cols,
+				postResample.rows, fingerPosition,
+				requiredDPI) :
+			    NFIQ2::FingerprintImageData(grayscaleRawData,
+				grayscaleRawData.size(), imageWidth,
+				imageHeight, fingerPosition, requiredDPI);
+
+			features =
+			    NFIQ2::QualityFeatures::computeQualityFeatures(
+				wrappedImage);
+			score = model.computeQualityScore(features);
+		}
 	} catch (const NFIQ2::Exception &e) {
 		std::string errStr {
 			"Error: NFIQ2 computeQualityScore returned an error code: "
@@ -387,6 +410,12 @@ NFIQ2UI::executeSingle(std::shared_ptr<BE::Image::Image> img,
 		// print just the plain score to std::out
 		logger->printSingle(score);
 
+	} else if (scoreOnly) {
+
+		// Print score with optional headers
+		logger->printScore(name, fingerPosition, score, warning,
+		    imageProps.quantized, imageProps.resampled, {}, {}, {});
+
 	} else {
 
 		// Print full score with optional headers